@@ -0,0 +1,26 @@
+#version 330
+// From vertex shader
+in vec2 texcoord;
+
+// Application data
+uniform sampler2D sampler0; // blurred edges, at a reduced scale
+uniform sampler2D sampler1; // the full scale image the edges were taken from
+uniform vec3 fcolor;
+uniform vec2 uv1;
+uniform vec2 uv2;
+
+// Output color
+layout(location = 0) out  vec4 color;
+const vec3 glowColor = vec3(0.28, 0.86, 0.98);
+
+void main()
+{
+    vec2 uv_delta = vec2(uv2.x - uv1.x, uv2.y - uv1.y);
+    vec2 true_uv = vec2(
+        uv1.x + texcoord.x * uv_delta.x,
+        uv1.y + texcoord.y * uv_delta.y
+    );
+    vec3 glow = texture(sampler0, vec2(true_uv.x, true_uv.y)).rgb;
+    vec4 base = texture(sampler1, vec2(true_uv.x, true_uv.y));
+    color = vec4(base.rgb + glowColor * clamp(glow, 0.0, 1.0), base.a);
+}
@@ -0,0 +1,20 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#ifndef PANDAEXPRESS_CHUNK_MEMBER_H
+#define PANDAEXPRESS_CHUNK_MEMBER_H
+
+#include <cstdint>
+
+/***
+ * This component ties a level entity to the streamed chunk that spawned it, the entity is
+ * despawned along with the chunk once the camera has left the chunk behind
+ */
+struct ChunkMember {
+    uint32_t chunk;
+
+    ChunkMember(uint32_t chunk) : chunk(chunk) {}
+};
+
+#endif //PANDAEXPRESS_CHUNK_MEMBER_H
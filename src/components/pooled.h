@@ -0,0 +1,20 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#ifndef PANDAEXPRESS_POOLED_H
+#define PANDAEXPRESS_POOLED_H
+
+#include "level/prefab.h"
+
+/***
+ * This component marks an entity as spawned from a prefab, so despawning it parks it in
+ * its prefab's free list instead of destroying it
+ */
+struct Pooled {
+    PrefabID prefab;
+
+    Pooled(PrefabID prefab) : prefab(prefab) {}
+};
+
+#endif //PANDAEXPRESS_POOLED_H
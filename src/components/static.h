@@ -0,0 +1,20 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#ifndef PANDAEXPRESS_STATIC_H
+#define PANDAEXPRESS_STATIC_H
+
+/***
+ * Entities that never move once spawned, like terrain. SpriteTransformSystem copies their
+ * Transform into their Sprite once and skips them from then on
+ */
+
+struct Static {
+    bool synced;
+
+    Static() :
+            synced(false) {}
+};
+
+#endif //PANDAEXPRESS_STATIC_H
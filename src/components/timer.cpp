@@ -2,56 +2,117 @@
 // Created by cowan on 01/03/19.
 //
 
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
 #include "timer.h"
 
 using namespace std;
 
+namespace {
+    struct LabelTable {
+        mutex lock;
+        unordered_map<string, TimerLabel> ids;
+    };
+
+    LabelTable& labels() {
+        static LabelTable table;
+        return table;
+    }
+}
+
 Timer::Timer() {
     curr_time = 0;
+    unscheduled = false;
 }
 
-bool::Timer::watch_exists(string label){
-    return(watches.find(label)!=watches.end());
+TimerLabel Timer::label(const string& name) {
+    LabelTable& table = labels();
+    lock_guard<mutex> guard(table.lock);
+    auto it = table.ids.find(name);
+    if (it != table.ids.end()) {
+        return it->second;
+    }
+    auto id = static_cast<TimerLabel>(table.ids.size());
+    table.ids.emplace(name, id);
+    return id;
 }
 
-void Timer::save_watch(string label, float time) {
-    watches[label] = {time, curr_time + time};
+const Watch* Timer::find(TimerLabel label) const {
+    for (auto& watch : watches) {
+        if (watch.label == label) {
+            return &watch;
+        }
+    }
+    return nullptr;
+}
+
+Watch* Timer::find(TimerLabel label) {
+    return const_cast<Watch*>(static_cast<const Timer*>(this)->find(label));
 }
 
-bool Timer::is_done(std::string label) {
-    if (watches.find(label) == watches.end()) {
+bool::Timer::watch_exists(TimerLabel label) const {
+    return find(label) != nullptr;
+}
+
+void Timer::save_watch(TimerLabel label, float time) {
+    Watch* watch = find(label);
+    if (watch == nullptr) {
+        watches.push_back({label, time, curr_time + time, 0});
+    } else {
+        *watch = {label, time, curr_time + time, 0};
+    }
+    unscheduled = true;
+}
+
+bool Timer::is_done(TimerLabel label) const {
+    const Watch* watch = find(label);
+    if (watch == nullptr) {
         return false;
     }
 
-    return watches[label].target_time <= curr_time;
+    return watch->target_time <= curr_time;
 }
 
 void Timer::update(float delta_time) {
     curr_time = curr_time + delta_time;
 }
 
-void Timer::reset_watch(std::string label) {
-    if (watches.find(label) == watches.end()) {
+void Timer::reset_watch(TimerLabel label) {
+    Watch* watch = find(label);
+    if (watch == nullptr) {
         return;
     }
 
-    Watch watch = watches[label];
-    watch.target_time = curr_time + watch.time;
-    watches[label] = watch;
+    watch->target_time = curr_time + watch->time;
+    watch->scheduled = 0;
+    unscheduled = true;
 }
 
-bool Timer::exists(string label) {
-    return (watches.find(label) != watches.end());
+bool Timer::exists(TimerLabel label) const {
+    return find(label) != nullptr;
 }
 
-void Timer::remove(std::string label) {
-    watches.erase(label);
+void Timer::remove(TimerLabel label) {
+    watches.erase(remove_if(watches.begin(), watches.end(), [label](const Watch& watch) {
+        return watch.label == label;
+    }), watches.end());
 }
 
-float Timer::get_curr_time() {
+float Timer::get_curr_time() const {
     return curr_time;
 }
 
-float Timer::get_target_time(std::string label){
-    return watches[label].target_time;
+float Timer::get_target_time(TimerLabel label) const {
+    const Watch* watch = find(label);
+    return watch != nullptr ? watch->target_time : 0.f;
+}
+
+bool Timer::has_unscheduled() const {
+    return unscheduled;
+}
+
+bool Timer::is_scheduled(TimerLabel label, uint32_t entry) const {
+    const Watch* watch = find(label);
+    return watch != nullptr && watch->scheduled == entry;
 }
@@ -5,31 +5,63 @@
 #ifndef PANDAEXPRESS_TIMER_H
 #define PANDAEXPRESS_TIMER_H
 
-#include <unordered_map>
+#include <cstdint>
 #include <string>
+#include <vector>
+
+// Watch labels are interned once, when the systems and scenes naming them are constructed,
+// so the per-frame checks compare small integers instead of hashing strings
+typedef uint16_t TimerLabel;
 
 struct Watch {
+    TimerLabel label;
     float time;
     float target_time;
+    uint32_t scheduled; // TimerSystem's wheel entry for target_time, 0 until it's scheduled
 };
 
 class Timer {
 public:
     Timer();
-    bool is_done(std::string label);
-    bool watch_exists(std::string label);
-    void save_watch(std::string label, float time);
+
+    // the same name always gives the same label, safe to call from any thread
+    static TimerLabel label(const std::string& name);
+
+    bool is_done(TimerLabel label) const;
+    bool watch_exists(TimerLabel label) const;
+    void save_watch(TimerLabel label, float time);
     void update(float delta_time);
-    void reset_watch(std::string label);
-    bool exists(std::string label);
-    void remove(std::string label);
-    float get_curr_time();
-    float get_target_time(std::string label);
+    void reset_watch(TimerLabel label);
+    bool exists(TimerLabel label) const;
+    void remove(TimerLabel label);
+    float get_curr_time() const;
+    float get_target_time(TimerLabel label) const;
 
+    // watches saved or reset since schedule() last ran
+    bool has_unscheduled() const;
+
+    // hands every unscheduled watch to schedule(label, seconds left), which returns its wheel entry
+    template<typename Schedule>
+    void schedule(Schedule schedule) {
+        for (auto& watch : watches) {
+            if (watch.scheduled == 0) {
+                watch.scheduled = schedule(watch.label, watch.target_time - curr_time);
+            }
+        }
+        unscheduled = false;
+    }
+
+    // false once the watch is removed, saved or reset after the entry was scheduled
+    bool is_scheduled(TimerLabel label, uint32_t entry) const;
 
 private:
+    const Watch* find(TimerLabel label) const;
+    Watch* find(TimerLabel label);
+
     float curr_time;
-    std::unordered_map<std::string, Watch> watches;
+    bool unscheduled;
+    // a timer holds a handful of watches at most, a linear scan beats any map
+    std::vector<Watch> watches;
 };
 
 
@@ -7,7 +7,8 @@ Background::Background(Texture texture, Shader shader, Mesh mesh, int z, bool in
         sp1_(Sprite(texture, shader, mesh)),
         sp2_(Sprite(texture, shader, mesh)),
         z(z),
-        infinite(infinite) {
+        infinite(infinite),
+        version_(next_render_version()) {
 }
 
 Background::Background(Texture texture, Shader shader, Mesh mesh, int z) :
@@ -16,7 +17,8 @@ Background::Background(Texture texture, Shader shader, Mesh mesh, int z) :
         sp1_(Sprite(texture, shader, mesh)),
         sp2_(Sprite(texture, shader, mesh)),
         z(z),
-        infinite(true) {
+        infinite(true),
+        version_(next_render_version()) {
 }
 
 Background::Background(const Background &other) :
@@ -25,7 +27,8 @@ Background::Background(const Background &other) :
         sp1_(other.sp1_),
         sp2_(other.sp2_),
         z(other.z),
-        infinite(other.infinite) {}
+        infinite(other.infinite),
+        version_(other.version_) {}
 
 
 void Background::draw(const mat3 &projection) {
@@ -45,7 +48,11 @@ vec2 Background::pos2() {
 }
 
 void Background::set_pos1(const vec2 &pos) {
-    sp1_.set_pos(pos.x, pos.y);
+    vec2 old = sp1_.pos();
+    if (old.x != pos.x || old.y != pos.y) {
+        sp1_.set_pos(pos.x, pos.y);
+        version_ = next_render_version();
+    }
 }
 
 void Background::set_pos1(float x, float y) {
@@ -53,7 +60,11 @@ void Background::set_pos1(float x, float y) {
 }
 
 void Background::set_pos2(const vec2 &pos) {
-    sp2_.set_pos(pos.x, pos.y);
+    vec2 old = sp2_.pos();
+    if (old.x != pos.x || old.y != pos.y) {
+        sp2_.set_pos(pos.x, pos.y);
+        version_ = next_render_version();
+    }
 }
 
 void Background::set_pos2(float x, float y) {
@@ -66,8 +77,13 @@ vec2 Background::scale() {
 }
 
 void Background::set_scale(const vec2 &scale) {
+    vec2 old = sp1_.scale();
     sp1_.set_scale_int(scale.x, scale.y);
     sp2_.set_scale_int(scale.x, scale.y);
+    vec2 now = sp1_.scale();
+    if (old.x != now.x || old.y != now.y) {
+        version_ = next_render_version();
+    }
 }
 
 void Background::set_scale(float x_scale, float y_scale) {
@@ -87,8 +103,11 @@ float Background::rotation_rad() {
 }
 
 void Background::set_rotation_rad(float theta) {
-    sp1_.set_rotation_rad(theta);
-    sp2_.set_rotation_rad(theta);
+    if (sp1_.rotation_rad() != theta) {
+        sp1_.set_rotation_rad(theta);
+        sp2_.set_rotation_rad(theta);
+        version_ = next_render_version();
+    }
 }
 
 int Background::z_pos() {
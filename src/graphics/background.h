@@ -14,6 +14,7 @@ private:
     Sprite sp1_, sp2_;
     int z;
     bool infinite;
+    uint32_t version_;
 
 public:
     Background(Texture texture, Shader shader, Mesh mesh, int z, bool infinite);
@@ -23,6 +24,10 @@ public:
 
     void draw(const mat3 &projection);
 
+    bool cacheable() const override { return true; }
+
+    uint32_t version() const override { return version_; }
+
     vec2 pos1();
 
     vec2 pos2();
@@ -256,6 +256,7 @@ Cave::Cave(Mesh mesh, Shader shader, vec2 size, vec2 scale, bool growing) :
     position_ = {0.f, 0.f};
     rotation_ = 0.f;
     status_ = 0;
+    version_ = next_render_version();
     growing = growing;
 }
 
@@ -265,7 +266,8 @@ Cave::Cave(const Cave &other) :
         position_(other.position_),
         scale_(other.scale_),
         rotation_(other.rotation_),
-        status_(other.status_)
+        status_(other.status_),
+        version_(other.version_)
 {}
 
 void Cave::draw(const mat3 &projection) {
@@ -322,10 +324,12 @@ vec2 Cave::pos() {
 
 void Cave::set_pos(const vec2 &pos) {
     position_ = {pos.x, pos.y};
+    version_ = next_render_version();
 }
 
 void Cave::set_pos(float x, float y) {
     position_ = {x, y};
+    version_ = next_render_version();
 }
 
 vec2 Cave::scale() {
@@ -334,10 +338,12 @@ vec2 Cave::scale() {
 
 void Cave::set_scale(const vec2 &scale) {
     scale_ = {scale.x, scale.y};
+    version_ = next_render_version();
 }
 
 void Cave::set_scale(float x_scale, float y_scale) {
     scale_ = {x_scale, y_scale};
+    version_ = next_render_version();
 }
 
 vec2 Cave::size() {
@@ -346,6 +352,7 @@ vec2 Cave::size() {
 
 void Cave::set_size(int x_size, int y_size) {
     size_ = {(float) x_size, (float) y_size};
+    version_ = next_render_version();
 }
 
 float Cave::rotation_rad() {
@@ -354,6 +361,7 @@ float Cave::rotation_rad() {
 
 void Cave::set_rotation_rad(float theta) {
     rotation_ = theta;
+    version_ = next_render_version();
 }
 
 vec3 Cave::color_start() {
@@ -362,10 +370,12 @@ vec3 Cave::color_start() {
 
 void Cave::set_color_start(const vec3 &color) {
     color_start_ = {color.x, color.y, color.z};
+    version_ = next_render_version();
 }
 
 void Cave::set_color_start(float r, float g, float b) {
     color_start_ = {r, g, b};
+    version_ = next_render_version();
 }
 
 vec3 Cave::color_end() {
@@ -374,10 +384,12 @@ vec3 Cave::color_end() {
 
 void Cave::set_color_end(const vec3 &color) {
     color_end_ = {color.x, color.y, color.z};
+    version_ = next_render_version();
 }
 
 void Cave::set_color_end(float r, float g, float b) {
     color_end_ = {r, g, b};
+    version_ = next_render_version();
 }
 
 void Cave::set_status(int flag) {
@@ -17,6 +17,7 @@ private:
     vec3 color_start_, color_end_;
     float rotation_;
     int status_;
+    uint32_t version_;
 public:
     static Vertex vertices[41];
     static uint16_t indices[168];
@@ -29,6 +30,10 @@ public:
 
     void draw(const mat3& projection);
 
+    bool cacheable() const override { return true; }
+
+    uint32_t version() const override { return version_; }
+
     vec2 pos();
     void set_pos(const vec2& pos);
     void set_pos(float x, float y);
@@ -0,0 +1,104 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#include <GL/glew.h>
+#include <cstring>
+#include "layer_cache.h"
+#include "camera.h"
+
+static bool same_projection(const mat3& a, const mat3& b) {
+    return memcmp(&a, &b, sizeof(mat3)) == 0;
+}
+
+size_t LayerCache::update(const FrameVector<Renderable*>& sorted, const mat3& projection,
+                          Window& window, Shader shader, Mesh mesh) {
+    // the run of cacheable layers at the bottom of this frame
+    size_t run = 0;
+    while (run < sorted.size() && sorted[run]->cacheable()) {
+        run++;
+    }
+
+    // the part of it that was drawn the same way last frame
+    size_t stable = 0;
+    if (!previous_.empty() && same_projection(projection, previous_projection_)) {
+        while (stable < run && stable < previous_.size() &&
+               previous_[stable].renderable == sorted[stable] &&
+               previous_[stable].version == sorted[stable]->version()) {
+            stable++;
+        }
+    }
+
+    previous_.clear();
+    for (size_t i = 0; i < run; i++) {
+        previous_.push_back({sorted[i], sorted[i]->version()});
+    }
+    previous_projection_ = projection;
+
+    if (stable == 0) {
+        return 0;
+    }
+
+    bool hit = quad_ && cached_.size() == stable &&
+               same_projection(projection, cached_projection_);
+    vec3 color = window.clear_color();
+    hit = hit && color.x == cached_color_.x && color.y == cached_color_.y && color.z == cached_color_.z;
+    for (size_t i = 0; hit && i < stable; i++) {
+        hit = cached_[i].renderable == sorted[i] && cached_[i].version == sorted[i]->version();
+    }
+
+    if (!hit) {
+        rebuild(sorted, stable, projection, window, shader, mesh);
+    }
+    return stable;
+}
+
+void LayerCache::rebuild(const FrameVector<Renderable*>& sorted, size_t count, const mat3& projection,
+                         Window& window, Shader shader, Mesh mesh) {
+    vec2 size = window.size();
+    auto width = (uint32_t) size.x;
+    auto height = (uint32_t) size.y;
+    if (!framebuffer_) {
+        framebuffer_ = std::make_unique<Framebuffer>(width, height);
+    } else if (framebuffer_->width() != width || framebuffer_->height() != height) {
+        framebuffer_->resize(width, height);
+    }
+
+    cached_color_ = window.clear_color();
+    cached_projection_ = projection;
+    cached_.clear();
+
+    framebuffer_->bind();
+    glClearColor(cached_color_.x, cached_color_.y, cached_color_.z, 1);
+    glClear(GL_COLOR_BUFFER_BIT);
+    for (size_t i = 0; i < count; i++) {
+        sorted[i]->draw(projection);
+        cached_.push_back({sorted[i], sorted[i]->version()});
+    }
+    framebuffer_->unbind();
+
+    quad_ = std::make_unique<Sprite>(framebuffer_->get_texture(), shader, mesh);
+    quad_->set_size((int) width, (int) height);
+    quad_->set_scale(1, -1);
+    quad_->set_pos(0, 0);
+
+    auto screen_camera = Camera(width, height, 0, 0);
+    screen_camera.compose();
+    screen_projection_ = screen_camera.get_projection();
+}
+
+void LayerCache::invalidate() {
+    cached_.clear();
+    previous_.clear();
+    quad_.reset();
+}
+
+const mat3& LayerCache::screen_projection() const {
+    return screen_projection_;
+}
+
+void LayerCache::draw(const mat3& projection) {
+    if (quad_) {
+        quad_->draw(projection);
+    }
+}
@@ -0,0 +1,58 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "framebuffer.h"
+#include "render.h"
+#include "sprite.h"
+#include "window.h"
+#include "../util/frame_arena.h"
+
+// Keeps the bottom run of static layers (backgrounds, caves) in a texture so it
+// can be drawn as a single quad. The run is the longest prefix of the depth-sorted
+// renderables that are cacheable and haven't changed since the last frame.
+// The texture is rebuilt only when that run, a layer's version, the camera
+// or the clear colour changes.
+class LayerCache : public Renderable {
+private:
+    struct CachedLayer {
+        const Renderable* renderable;
+        uint32_t version;
+    };
+
+    std::unique_ptr<Framebuffer> framebuffer_;
+    std::unique_ptr<Sprite> quad_;
+    mat3 screen_projection_;
+
+    // layers in the texture, and what they were drawn with
+    std::vector<CachedLayer> cached_;
+    mat3 cached_projection_;
+    vec3 cached_color_;
+
+    // cacheable layers seen last frame
+    std::vector<CachedLayer> previous_;
+    mat3 previous_projection_;
+
+    void rebuild(const FrameVector<Renderable*>& sorted, size_t count, const mat3& projection,
+                 Window& window, Shader shader, Mesh mesh);
+
+public:
+    // renders the stable static layers into the cache if needed, returns how many
+    // of the depth-sorted renderables are covered by it (0 if the cache shouldn't be drawn)
+    size_t update(const FrameVector<Renderable*>& sorted, const mat3& projection,
+                  Window& window, Shader shader, Mesh mesh);
+
+    // drops the cached texture contents, the next stable frame rebuilds it
+    void invalidate();
+
+    // the projection that makes draw() cover the whole target
+    const mat3& screen_projection() const;
+
+    // draws the cached layers as one quad, pass screen_projection() since the quad is in screen space
+    void draw(const mat3& projection) override;
+};
@@ -4,7 +4,7 @@
 
 #include "mesh_manager.h"
 
-MeshManager::MeshManager() : meshes_() {}
+MeshManager::MeshManager() : meshes_(), handles_() {}
 
 MeshManager::~MeshManager() {
     for (auto &entry: meshes_) {
@@ -49,7 +49,8 @@ bool MeshManager::load_mesh(
     bool result = !gl_has_errors("mesh_manager");
 
     auto mesh = Mesh(vao, vbo, ibo);
-    meshes_.insert(std::pair<std::string, Mesh>(key_str, mesh));
+    auto it = meshes_.insert(std::pair<std::string, Mesh>(key_str, mesh)).first;
+    handles_.add(name, &it->second);
 
     return result;
 }
@@ -85,7 +86,8 @@ bool MeshManager::load_mesh(
     bool result = !gl_has_errors("mesh_manager");
 
     auto mesh = Mesh(vao, vbo, ibo);
-    meshes_.insert(std::pair<std::string, Mesh>(key_str, mesh));
+    auto it = meshes_.insert(std::pair<std::string, Mesh>(key_str, mesh)).first;
+    handles_.add(name, &it->second);
 
     return result;
 }
@@ -121,7 +123,8 @@ bool MeshManager::load_mesh(
     bool result = !gl_has_errors("mesh_manager");
 
     auto mesh = Mesh(vao, vbo, ibo);
-    meshes_.insert(std::pair<std::string, Mesh>(key_str, mesh));
+    auto it = meshes_.insert(std::pair<std::string, Mesh>(key_str, mesh)).first;
+    handles_.add(name, &it->second);
 
     return result;
 }
@@ -129,4 +132,12 @@ bool MeshManager::load_mesh(
 Mesh MeshManager::get_mesh(const char *name) {
     auto key_str = std::string(name);
     return meshes_.at(key_str);
+}
+
+MeshHandle MeshManager::handle(ResourceName name) const {
+    return handles_.find(name);
+}
+
+Mesh MeshManager::get_mesh(MeshHandle handle) {
+    return handles_[handle];
 }
\ No newline at end of file
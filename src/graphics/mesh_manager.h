@@ -10,12 +10,16 @@
 
 #include "../util/gl_utils.h"
 #include "mesh.h"
+#include "../util/resource_name.h"
+
+typedef ResourceHandle MeshHandle;
 
 // Manages loading/unloading of textures
 
 class MeshManager {
 private:
     std::unordered_map<std::string, Mesh> meshes_;
+    HandleTable<Mesh> handles_;
 
 public:
     MeshManager();
@@ -46,4 +50,9 @@ public:
     );
 
     Mesh get_mesh(const char* name);
+
+    // INVALID_RESOURCE_HANDLE if no mesh was loaded with that name
+    MeshHandle handle(ResourceName name) const;
+
+    Mesh get_mesh(MeshHandle handle);
 };
\ No newline at end of file
@@ -0,0 +1,58 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#include "post_process_chain.h"
+
+void PostProcessChain::add_pass(const std::string& name, Shader shader, PassScale scale, PassInput input) {
+    for (auto& pass : passes_) {
+        if (pass.name == name) {
+            pass.shader = shader;
+            pass.scale = scale;
+            pass.input = input;
+            return;
+        }
+    }
+    passes_.push_back({name, shader, scale, input});
+}
+
+void PostProcessChain::remove_pass(const std::string& name) {
+    for (auto it = passes_.begin(); it != passes_.end(); ++it) {
+        if (it->name == name) {
+            passes_.erase(it);
+            return;
+        }
+    }
+}
+
+bool PostProcessChain::has_pass(const std::string& name) const {
+    for (auto& pass : passes_) {
+        if (pass.name == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void PostProcessChain::set_uniform_float(const std::string& name, const char* loc, float val) {
+    for (auto& pass : passes_) {
+        if (pass.name == name) {
+            pass.shader.bind();
+            pass.shader.set_uniform_float(loc, val);
+            pass.shader.unbind();
+            return;
+        }
+    }
+}
+
+void PostProcessChain::clear() {
+    passes_.clear();
+}
+
+bool PostProcessChain::empty() const {
+    return passes_.empty();
+}
+
+const std::vector<PostProcessPass>& PostProcessChain::passes() const {
+    return passes_;
+}
@@ -0,0 +1,61 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "shader.h"
+
+// the vape effect, added by the powerup and by the jungle intro, so both drop the same pass
+static const char* const VAPE_PASS = "VAPE";
+
+// Resolution a pass renders at, as a divisor of the window size
+enum PassScale {
+    FULL_SCALE = 1,
+    HALF_SCALE = 2,
+    QUARTER_SCALE = 4
+};
+
+// Image a pass samples from sampler0
+enum PassInput {
+    PREVIOUS_PASS,   // output of the pass before it, or the scene for the first pass
+    FULL_SCALE_INPUT // output of the last full scale pass, or the scene if there's none yet
+};
+
+struct PostProcessPass {
+    std::string name;
+    Shader shader;
+    PassScale scale;
+    PassInput input;
+};
+
+// Ordered list of post-process passes, run by Window::display
+// Passes are keyed by name so scenes and powerups can add and remove
+// their own effect without clobbering each other's.
+// Every pass also gets the last full scale image bound to sampler1, so a full scale pass
+// following reduced scale ones can composite them over it.
+class PostProcessChain {
+private:
+    std::vector<PostProcessPass> passes_;
+
+public:
+    // appends a pass, or replaces the shader and scale of the pass with the same name
+    void add_pass(const std::string& name, Shader shader,
+                  PassScale scale = FULL_SCALE, PassInput input = PREVIOUS_PASS);
+
+    void remove_pass(const std::string& name);
+
+    bool has_pass(const std::string& name) const;
+
+    // sets a uniform on the named pass, does nothing if the pass isn't in the chain
+    void set_uniform_float(const std::string& name, const char* loc, float val);
+
+    void clear();
+
+    bool empty() const;
+
+    const std::vector<PostProcessPass>& passes() const;
+};
@@ -5,13 +5,28 @@
 #pragma once
 
 
+#include <atomic>
+#include <cstdint>
 #include <components/layer.h>
 #include "../util/gl_utils.h"
 
+// returns a new value for Renderable::version(), unique across all renderables,
+// safe to call from systems running on the scheduler's workers
+inline uint32_t next_render_version() {
+    static std::atomic<uint32_t> version(0);
+    return version.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
 class Renderable {
 public:
     int depth = DEFAULT_LAYER;
     virtual void draw(const mat3& projection) = 0;
+
+    // true if the renderable only changes through its setters, so LayerCache can keep it in a texture
+    virtual bool cacheable() const { return false; }
+
+    // changes whenever the drawn content of a cacheable renderable changes
+    virtual uint32_t version() const { return 0; }
 };
 
 // interface for renderables, like framebuffers or the window
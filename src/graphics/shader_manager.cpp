@@ -4,14 +4,41 @@
 
 #include "shader_manager.h"
 
-#include <iostream>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
-#include <sstream>
+#include <iostream>
+#include <vector>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
 
 #include "../util/gl_utils.h"
+#include "../util/hash.h"
+
+static bool read_source(const char* path, std::string& source) {
+    std::ifstream is(path, std::ifstream::in | std::ifstream::binary);
+    if (!is.good()) {
+        return false;
+    }
+    is.seekg(0, std::ios::end);
+    source.resize((size_t) is.tellg());
+    is.seekg(0, std::ios::beg);
+    is.read(&source[0], source.size());
+    return is.good() || is.eof();
+}
 
 ShaderManager::ShaderManager() :
-    shaders_()
+    shaders_(),
+    handles_(),
+    cache_dir_(),
+    binaries_supported_(false),
+    driver_hash_(0),
+    cache_hits_(0),
+    cache_misses_(0)
 {}
 
 ShaderManager::~ShaderManager() {
@@ -21,6 +48,39 @@ ShaderManager::~ShaderManager() {
     }
 }
 
+bool ShaderManager::set_cache_dir(const char* path) {
+    GLint formats = 0;
+    if (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary) {
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    }
+    binaries_supported_ = formats > 0;
+    if (!binaries_supported_) {
+        printf("shaders: driver doesn't support program binaries, not caching\n");
+        return false;
+    }
+
+#ifdef _WIN32
+    _mkdir(path);
+#else
+    mkdir(path, 0755);
+#endif
+    cache_dir_ = path;
+
+    uint64_t hash = FNV_OFFSET_BASIS;
+    for (GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+        auto value = (const char*) glGetString(name);
+        if (value != nullptr) {
+            hash = hash_bytes(value, strlen(value) + 1, hash);
+        }
+    }
+    driver_hash_ = hash;
+    return true;
+}
+
+void ShaderManager::print_cache_stats() {
+    printf("shaders: %zu from the binary cache, %zu compiled\n", cache_hits_, cache_misses_);
+}
+
 // adapted from salmon game code
 
 bool ShaderManager::load_shader(const char *vert_path, const char *frag_path, const char *name) {
@@ -33,22 +93,26 @@ bool ShaderManager::load_shader(const char *vert_path, const char *frag_path, co
 
     GLuint vert, frag, program;
 
-    // Opening files
-    std::ifstream vs_is, fs_is;
-    vs_is.open(vert_path, std::ifstream::in);
-    fs_is.open(frag_path,  std::ifstream::in);
-
-    if (!vs_is.good() || !fs_is.good()) {
+    // Reading sources
+    std::string vs_str, fs_str;
+    if (!read_source(vert_path, vs_str) || !read_source(frag_path, fs_str)) {
         fprintf(stderr, "Failed to load shader files %s, %s\n", vert_path, frag_path);
         return false;
     }
 
-    // Reading sources
-    std::stringstream vs_ss, fs_ss;
-    vs_ss << vs_is.rdbuf();
-    fs_ss << fs_is.rdbuf();
-    std::string vs_str = vs_ss.str();
-    std::string fs_str = fs_ss.str();
+    std::string binary_path;
+    if (binaries_supported_) {
+        binary_path = cache_path(name, vs_str, fs_str);
+        program = load_cached_program(binary_path);
+        if (program != 0) {
+            cache_hits_++;
+            auto it = shaders_.insert(std::pair<std::string, Shader>(key_str, Shader(0, 0, program))).first;
+            handles_.add(name, &it->second);
+            return true;
+        }
+    }
+    cache_misses_++;
+
     const char* vs_src = vs_str.c_str();
     const char* fs_src = fs_str.c_str();
     GLsizei vs_len = (GLsizei)vs_str.size();
@@ -74,6 +138,9 @@ bool ShaderManager::load_shader(const char *vert_path, const char *frag_path, co
     program = glCreateProgram();
     glAttachShader(program, vert);
     glAttachShader(program, frag);
+    if (binaries_supported_) {
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
     glLinkProgram(program);
     {
         GLint is_linked = 0;
@@ -98,8 +165,13 @@ bool ShaderManager::load_shader(const char *vert_path, const char *frag_path, co
         return false;
     }
 
+    if (binaries_supported_) {
+        save_cached_program(binary_path, program);
+    }
+
     auto shader = Shader(vert, frag, program);
-    shaders_.insert(std::pair<std::string, Shader>(key_str, shader));
+    auto it = shaders_.insert(std::pair<std::string, Shader>(key_str, shader)).first;
+    handles_.add(name, &it->second);
 
     return true;
 }
@@ -109,8 +181,82 @@ Shader ShaderManager::get_shader(const char* name) {
     return shaders_.at(key_str);
 }
 
+ShaderHandle ShaderManager::handle(ResourceName name) const {
+    return handles_.find(name);
+}
+
+Shader ShaderManager::get_shader(ShaderHandle handle) {
+    return handles_[handle];
+}
+
 void ShaderManager::release_shader(GLuint vert_id, GLuint frag_id, GLuint program_id) {
     glDeleteProgram(program_id);
     glDeleteShader(vert_id);
     glDeleteShader(frag_id);
-}
\ No newline at end of file
+}
+std::string ShaderManager::cache_path(const char* name, const std::string& vs_str, const std::string& fs_str) {
+    uint64_t hash = hash_bytes(vs_str.data(), vs_str.size(), driver_hash_);
+    hash = hash_bytes(fs_str.data(), fs_str.size(), hash);
+    char file[32];
+    snprintf(file, sizeof(file), "_%016llx.bin", (unsigned long long) hash);
+    return cache_dir_ + "/" + name + file;
+}
+
+GLuint ShaderManager::load_cached_program(const std::string& path) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return 0;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    // a GLenum format followed by the binary
+    GLenum format = 0;
+    std::vector<char> binary(size > (long) sizeof(format) ? size - sizeof(format) : 0);
+    bool read = !binary.empty() &&
+                fread(&format, sizeof(format), 1, file) == 1 &&
+                fread(binary.data(), 1, binary.size(), file) == binary.size();
+    fclose(file);
+
+    GLuint program = 0;
+    if (read) {
+        gl_flush_errors();
+        program = glCreateProgram();
+        glProgramBinary(program, format, binary.data(), (GLsizei) binary.size());
+        GLint is_linked = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, &is_linked);
+        if (is_linked == GL_FALSE || gl_has_errors()) {
+            glDeleteProgram(program);
+            program = 0;
+        }
+    }
+    if (program == 0) {
+        // the driver changed in a way the key didn't catch, or the file is corrupt
+        fprintf(stderr, "Discarding shader cache file %s\n", path.c_str());
+        remove(path.c_str());
+    }
+    return program;
+}
+
+void ShaderManager::save_cached_program(const std::string& path, GLuint program) {
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+    std::vector<char> binary((size_t) length);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &length, &format, binary.data());
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return;
+    }
+    bool written = fwrite(&format, sizeof(format), 1, file) == 1 &&
+                   fwrite(binary.data(), 1, (size_t) length, file) == (size_t) length;
+    fclose(file);
+    if (!written) {
+        remove(path.c_str());
+    }
+}
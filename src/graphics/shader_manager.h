@@ -8,21 +8,51 @@
 #include <unordered_map>
 
 #include "shader.h"
+#include "../util/resource_name.h"
 
+typedef ResourceHandle ShaderHandle;
 
+
+// Linked programs are cached on disk with glGetProgramBinary when the driver supports it.
+// Cache files are keyed by a hash of both sources and the driver's vendor, renderer and
+// version strings, so a source edit or driver update just misses the cache.
+// A binary the driver rejects is deleted and the program is compiled from source.
 class ShaderManager {
 private:
     std::unordered_map<std::string, Shader> shaders_;
+    HandleTable<Shader> handles_;
+    std::string cache_dir_;
+    bool binaries_supported_;
+    uint64_t driver_hash_;
+    size_t cache_hits_, cache_misses_;
 
 public:
     ShaderManager();
     ~ShaderManager();
 
+    // enables the program binary cache in the given directory, creating it if needed
+    // must be called with a current GL context, returns false if the driver can't cache programs
+    bool set_cache_dir(const char* path);
+
     bool load_shader(const char* vert_path, const char* frag_path, const char* name);
 
     Shader get_shader(const char* name);
 
+    // INVALID_RESOURCE_HANDLE if no shader was loaded with that name
+    ShaderHandle handle(ResourceName name) const;
+
+    Shader get_shader(ShaderHandle handle);
+
+    void print_cache_stats();
+
 private:
 
     void release_shader(GLuint vert_id, GLuint frag_id, GLuint program_id);
+
+    std::string cache_path(const char* name, const std::string& vs_str, const std::string& fs_str);
+
+    // returns 0 if there's no usable binary, deleting the cache file if the driver rejects it
+    GLuint load_cached_program(const std::string& path);
+
+    void save_cached_program(const std::string& path, GLuint program);
 };
\ No newline at end of file
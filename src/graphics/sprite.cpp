@@ -39,6 +39,7 @@ Sprite::Sprite(Texture texture, Shader shader, Mesh mesh) :
     uv2_ = {1, 1};
     color_ = {1.f, 1.f, 1.f};
     rotation_ = 0.f;
+    transform_dirty_ = true;
 }
 
 Sprite::Sprite(const Sprite& other) :
@@ -51,21 +52,26 @@ Sprite::Sprite(const Sprite& other) :
         color_(other.color_),
         uv1_(other.uv1_),
         uv2_(other.uv2_),
-        rotation_(other.rotation_)
+        rotation_(other.rotation_),
+        transform_(other.transform_),
+        transform_dirty_(other.transform_dirty_)
 {}
 
 
 void Sprite::draw(const mat3& projection) {
     // transform
-    mat3 transform = {
-            { 1.f, 0.f, 0.f },
-            { 0.f, 1.f, 0.f },
-            { 0.f, 0.f, 1.f }
-    };
-
-    mul_in_place(transform, make_translate_mat3(position_.x, position_.y));
-    mul_in_place(transform, make_rotate_mat3(rotation_));
-    mul_in_place(transform, make_scale_mat3(scale_.x * pixel_scale_.x, scale_.y * pixel_scale_.y));
+    if (transform_dirty_) {
+        transform_ = {
+                { 1.f, 0.f, 0.f },
+                { 0.f, 1.f, 0.f },
+                { 0.f, 0.f, 1.f }
+        };
+
+        mul_in_place(transform_, make_translate_mat3(position_.x, position_.y));
+        mul_in_place(transform_, make_rotate_mat3(rotation_));
+        mul_in_place(transform_, make_scale_mat3(scale_.x * pixel_scale_.x, scale_.y * pixel_scale_.y));
+        transform_dirty_ = false;
+    }
 
     // bind shader
     shader_.bind();
@@ -84,7 +90,7 @@ void Sprite::draw(const mat3& projection) {
 
 
     //setup uniforms
-    shader_.set_uniform_mat3("transform", transform);
+    shader_.set_uniform_mat3("transform", transform_);
     shader_.set_uniform_vec3("fcolor", color_);
     shader_.set_uniform_mat3("projection", projection);
 
@@ -115,11 +121,14 @@ vec2 Sprite::pos() {
 }
 
 void Sprite::set_pos(const vec2& pos) {
-    position_ = { pos.x, pos.y };
+    set_pos(pos.x, pos.y);
 }
 
 void Sprite::set_pos(float x, float y) {
-    position_ = { x, y };
+    if (position_.x != x || position_.y != y) {
+        position_ = { x, y };
+        transform_dirty_ = true;
+    }
 }
 
 vec2 Sprite::scale() {
@@ -127,7 +136,7 @@ vec2 Sprite::scale() {
 }
 
 void Sprite::set_scale(const vec2& scale) {
-    scale_ = { scale.x, scale.y };
+    set_scale(scale.x, scale.y);
 }
 
 void Sprite::set_scale_int(float x_scale, float y_scale) {
@@ -137,11 +146,14 @@ void Sprite::set_scale_int(float x_scale, float y_scale) {
     float true_x_scale = (pixel_scale_.x * x_scale) / pix_x;
     float true_y_scale = (pixel_scale_.x * y_scale) / pix_x;
 
-    scale_ = { true_x_scale, true_y_scale };
+    set_scale(true_x_scale, true_y_scale);
 }
 
 void Sprite::set_scale(float x_scale, float y_scale) {
-    scale_ = { x_scale, y_scale };
+    if (scale_.x != x_scale || scale_.y != y_scale) {
+        scale_ = { x_scale, y_scale };
+        transform_dirty_ = true;
+    }
 }
 
 void Sprite::set_size(uint32_t width, uint32_t height) {
@@ -163,7 +175,10 @@ float Sprite::rotation_rad() {
 }
 
 void Sprite::set_rotation_rad(float theta) {
-    rotation_ = theta;
+    if (rotation_ != theta) {
+        rotation_ = theta;
+        transform_dirty_ = true;
+    }
 }
 
 vec3 Sprite::color() {
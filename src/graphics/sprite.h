@@ -20,6 +20,10 @@ private:
     vec3 color_;
     float rotation_;
 
+    // the model matrix, rebuilt by draw() only after the position, rotation or scale changed
+    mat3 transform_;
+    bool transform_dirty_;
+
 public:
     static TexturedVertex vertices[4];
     static uint16_t indices[6];
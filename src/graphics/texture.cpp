@@ -22,6 +22,10 @@ uint32_t Texture::height() {
     return height_;
 }
 
+GLuint Texture::id() {
+    return id_;
+}
+
 
 void Texture::bind() {
     glBindTexture(GL_TEXTURE_2D, id_);
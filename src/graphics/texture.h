@@ -23,6 +23,8 @@ public:
     uint32_t width();
     uint32_t height();
 
+    GLuint id();
+
     // bind the texture for rendering
     void bind();
 
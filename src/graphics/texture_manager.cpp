@@ -9,16 +9,50 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 
+#include <chrono>
+#include <vector>
+
 #include "../util/gl_utils.h"
+#include "../util/hash.h"
 
 TextureManager::TextureManager() :
-    textures_()
+    textures_(),
+    handles_(),
+    loader_(),
+    in_flight_(),
+    pack_(),
+    upload_ms_(0.f),
+    packed_count_(0),
+    stale_count_(0)
+{}
+
+TextureManager::AsyncLoader::AsyncLoader() :
+    workers(std::make_unique<WorkerPool>())
 {}
 
+TextureManager::AsyncLoader::~AsyncLoader() {
+    workers.reset();
+    for (auto& image : decoded) {
+        free_pixels(image);
+    }
+}
+
 TextureManager::~TextureManager() {
+    // workers may still be reading from the pack
+    loader_.reset();
     for (auto& texture: textures_) {
-        glDeleteTextures(1, &texture.second.id_);
+        glDeleteTextures(1, &texture.second.texture.id_);
+    }
+}
+
+bool TextureManager::open_pack(const char *path) {
+    pack_ = std::make_unique<TexturePack>();
+    if (!pack_->open(path)) {
+        pack_.reset();
+        return false;
     }
+    printf("textures: using pack %s with %zu textures\n", path, pack_->size());
+    return true;
 }
 
 bool TextureManager::load_texture(const char *path, const char *name) {
@@ -26,36 +60,323 @@ bool TextureManager::load_texture(const char *path, const char *name) {
         return false;
     }
     auto key_str = std::string(name);
-    if (textures_.count(key_str) > 0) {
+    if (textures_.count(key_str) > 0 || in_flight_.count(key_str) > 0) {
         return false; // Texture with given name already loaded!
     }
 
+    auto image = decode(pack_.get(), key_str, path);
+    if (image.pixels == nullptr) {
+        return false;
+    }
+    packed_count_ += image.packed ? 1 : 0;
+    stale_count_ += image.stale ? 1 : 0;
+    bool result = upload(create_entry(key_str, path, true), image.width, image.height, image.pixels);
+    free_pixels(image);
+
+    return result;
+}
+
+bool TextureManager::load_texture_async(const char *path, const char *name) {
+    if (path == nullptr) {
+        return false;
+    }
+    auto key_str = std::string(name);
+    if (textures_.count(key_str) > 0 || in_flight_.count(key_str) > 0) {
+        return false;
+    }
+    create_entry(key_str, path, true);
+    queue_decode(key_str, path);
+    return true;
+}
+
+bool TextureManager::register_texture(const char *path, const char *name) {
+    if (path == nullptr) {
+        return false;
+    }
+    auto key_str = std::string(name);
+    if (textures_.count(key_str) > 0) {
+        return false;
+    }
+
+    // the size is all we need until a scene acquires it
     int width, height;
+    if (!stbi_info(path, &width, &height, nullptr)) {
+        auto path_str = std::string(path);
+        size_t slash = path_str.find_last_of("/\\");
+        auto entry = pack_ ? pack_->find(path_str.substr(slash + 1)) : nullptr;
+        if (entry == nullptr) {
+            fprintf(stderr, "Failed to register texture %s from %s\n", name, path);
+            return false;
+        }
+        width = entry->width;
+        height = entry->height;
+    }
+    auto& entry = create_entry(key_str, path, false);
+    entry.texture.width_ = width;
+    entry.texture.height_ = height;
+    return true;
+}
+
+void TextureManager::acquire(const std::vector<std::string>& names) {
+    for (auto& name : names) {
+        auto it = textures_.find(name);
+        if (it == textures_.end()) {
+            fprintf(stderr, "Can't acquire unknown texture %s\n", name.c_str());
+            continue;
+        }
+        auto& entry = it->second;
+        entry.refs++;
+        if (!entry.resident && in_flight_.count(name) == 0) {
+            queue_decode(name, entry.path);
+        }
+    }
+}
+
+void TextureManager::release(const std::vector<std::string>& names) {
+    for (auto& name : names) {
+        auto it = textures_.find(name);
+        if (it != textures_.end() && it->second.refs > 0) {
+            it->second.refs--;
+        }
+    }
+}
+
+size_t TextureManager::evict_unreferenced() {
+    size_t freed = 0;
+    for (auto& texture : textures_) {
+        auto& entry = texture.second;
+        if (entry.pinned || entry.refs > 0 || !entry.resident) {
+            continue;
+        }
+        // keep the name alive so handles held by inactive scenes stay valid
+        glBindTexture(GL_TEXTURE_2D, entry.texture.id_);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 0, 0, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        entry.resident = false;
+        freed += texture_bytes(entry);
+    }
+    return freed;
+}
+
+bool TextureManager::is_resident(const std::string& name) const {
+    auto it = textures_.find(name);
+    return it != textures_.end() && it->second.resident;
+}
+
+size_t TextureManager::resident_bytes() const {
+    size_t bytes = 0;
+    for (auto& texture : textures_) {
+        if (texture.second.resident) {
+            bytes += texture_bytes(texture.second);
+        }
+    }
+    return bytes;
+}
+
+size_t TextureManager::resident_bytes(const std::vector<std::string>& names) const {
+    size_t bytes = 0;
+    for (auto& name : names) {
+        auto it = textures_.find(name);
+        if (it != textures_.end() && it->second.resident) {
+            bytes += texture_bytes(it->second);
+        }
+    }
+    return bytes;
+}
+
+size_t TextureManager::upload_pending(size_t max_uploads) {
+    if (!loader_ || in_flight_.empty()) {
+        return 0;
+    }
+    std::deque<DecodedImage> batch;
+    {
+        std::lock_guard<std::mutex> lock(loader_->mutex);
+        while (!loader_->decoded.empty() && batch.size() < max_uploads) {
+            batch.push_back(loader_->decoded.front());
+            loader_->decoded.pop_front();
+        }
+    }
+    for (auto& image : batch) {
+        upload_decoded(image);
+    }
+    return batch.size();
+}
+
+bool TextureManager::wait_for(const char *name) {
+    auto key_str = std::string(name);
+    while (in_flight_.count(key_str) > 0) {
+        std::deque<DecodedImage> batch;
+        {
+            std::unique_lock<std::mutex> lock(loader_->mutex);
+            loader_->decoded_ready.wait(lock, [this] { return !loader_->decoded.empty(); });
+            batch.swap(loader_->decoded);
+        }
+        // upload whatever is ready, not just the one we're waiting on
+        for (auto& image : batch) {
+            upload_decoded(image);
+        }
+    }
+    return is_resident(key_str);
+}
+
+void TextureManager::finish_loading() {
+    while (!in_flight_.empty()) {
+        wait_for(in_flight_.begin()->c_str());
+    }
+}
+
+size_t TextureManager::pending_count() const {
+    return in_flight_.size();
+}
+
+void TextureManager::print_load_stats() {
+    float decode_ms = 0.f;
+    if (loader_) {
+        std::lock_guard<std::mutex> lock(loader_->mutex);
+        decode_ms = loader_->decode_ms;
+    }
+    printf("textures: %zu loaded, %zu pending, %.1fms decoding on %zu workers, %.1fms uploading\n",
+           textures_.size(), in_flight_.size(), decode_ms,
+           loader_ ? loader_->workers->size() : (size_t) 0, upload_ms_);
+    printf("textures: %zu from the pack, %zu stale in the pack, %.1fMB resident\n",
+           packed_count_, stale_count_, resident_bytes() / (1024.f * 1024.f));
+}
+
+Texture TextureManager::get_texture(const char *name) {
+    auto key_str = std::string(name);
+    auto& entry = textures_.at(key_str);
+    if (entry.texture.width_ == 0 && in_flight_.count(key_str) > 0) {
+        // loaded eagerly but not decoded yet, so the size isn't known
+        wait_for(name);
+    }
+    return entry.texture;
+}
+
+TextureHandle TextureManager::handle(ResourceName name) const {
+    return handles_.find(name);
+}
+
+Texture TextureManager::get_texture(TextureHandle handle) {
+    auto& entry = handles_[handle];
+    if (entry.texture.width_ == 0 && in_flight_.count(entry.name) > 0) {
+        wait_for(entry.name.c_str());
+    }
+    return entry.texture;
+}
+
+TextureManager::DecodedImage TextureManager::decode(const TexturePack* pack, const std::string& name,
+                                                    const std::string& path) {
+    DecodedImage image = {name, path, 0, 0, nullptr, false, false};
+
+    std::vector<unsigned char> bytes;
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file != nullptr) {
+        fseek(file, 0, SEEK_END);
+        long size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        bytes.resize(size > 0 ? (size_t) size : 0);
+        if (size <= 0 || fread(bytes.data(), 1, bytes.size(), file) != bytes.size()) {
+            bytes.clear();
+        }
+        fclose(file);
+    }
+
+    const TexturePackEntry* entry = nullptr;
+    if (pack != nullptr) {
+        size_t slash = path.find_last_of("/\\");
+        entry = pack->find(slash == std::string::npos ? path : path.substr(slash + 1));
+    }
+    if (entry != nullptr) {
+        // use the pack if the PNG is gone or unchanged since it was packed
+        if (bytes.empty() || hash_bytes(bytes.data(), bytes.size()) == entry->source_hash) {
+            image.width = entry->width;
+            image.height = entry->height;
+            image.pixels = pack->pixels(*entry);
+            image.packed = true;
+            return image;
+        }
+        image.stale = true;
+    }
+
+    if (!bytes.empty()) {
+        image.pixels = stbi_load_from_memory(bytes.data(), (int) bytes.size(),
+                                             &image.width, &image.height, nullptr, 4);
+    }
+    return image;
+}
+
+void TextureManager::free_pixels(DecodedImage& image) {
+    if (!image.packed && image.pixels != nullptr) {
+        stbi_image_free((void*) image.pixels);
+    }
+    image.pixels = nullptr;
+}
+
+TextureManager::TextureEntry& TextureManager::create_entry(const std::string& name, const std::string& path,
+                                                           bool pinned) {
     GLuint id;
+    glGenTextures(1, &id);
+    TextureEntry entry = {name, path, Texture(0, 0, id), pinned, false, 0};
+    auto& inserted = textures_.insert(std::make_pair(name, entry)).first->second;
+    handles_.add(name.c_str(), &inserted);
+    return inserted;
+}
 
-    stbi_uc* data = stbi_load(path, &width, &height, nullptr, 4);
-    if (data == nullptr) {
-        return false;
+void TextureManager::queue_decode(const std::string& name, const std::string& path) {
+    if (!loader_) {
+        loader_ = std::make_unique<AsyncLoader>();
     }
+    in_flight_.insert(name);
+
+    AsyncLoader* loader = loader_.get();
+    const TexturePack* pack = pack_.get();
+    loader->workers->submit([loader, pack, name, path]() {
+        auto start = std::chrono::steady_clock::now();
+        DecodedImage image = decode(pack, name, path);
+        std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        {
+            std::lock_guard<std::mutex> lock(loader->mutex);
+            loader->decoded.push_back(image);
+            loader->decode_ms += elapsed.count();
+        }
+        loader->decoded_ready.notify_all();
+    });
+}
+
+bool TextureManager::upload(TextureEntry& entry, int width, int height, const unsigned char* pixels) {
+    auto start = std::chrono::steady_clock::now();
+
     gl_flush_errors();
-    glGenTextures(1, &id);
-    glBindTexture(GL_TEXTURE_2D, id);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+    glBindTexture(GL_TEXTURE_2D, entry.texture.id_);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    stbi_image_free(data);
 
     bool result = !gl_has_errors();
 
-    auto texture = Texture(width, height, id);
-    textures_.insert(std::pair<std::string, Texture>(key_str, texture));
+    entry.texture.width_ = width;
+    entry.texture.height_ = height;
+    entry.resident = true;
 
+    std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    upload_ms_ += elapsed.count();
     return result;
 }
 
-Texture TextureManager::get_texture(const char *name) {
-    auto key_str = std::string(name);
-    return textures_.at(key_str);
-}
\ No newline at end of file
+void TextureManager::upload_decoded(DecodedImage& image) {
+    in_flight_.erase(image.name);
+    if (image.pixels == nullptr) {
+        fprintf(stderr, "Failed to load texture %s from %s\n", image.name.c_str(), image.path.c_str());
+        return;
+    }
+    packed_count_ += image.packed ? 1 : 0;
+    stale_count_ += image.stale ? 1 : 0;
+    upload(textures_.at(image.name), image.width, image.height, image.pixels);
+    free_pixels(image);
+}
+
+size_t TextureManager::texture_bytes(const TextureEntry& entry) {
+    return (size_t) entry.texture.width_ * entry.texture.height_ * 4;
+}
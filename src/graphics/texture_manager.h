@@ -5,22 +5,149 @@
 #pragma once
 
 #include <GL/glew.h>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "texture.h"
+#include "texture_pack.h"
+#include "../util/resource_name.h"
+#include "../util/worker_pool.h"
+
+typedef ResourceHandle TextureHandle;
 
 // Manages loading/unloading of textures
+// Textures can be loaded synchronously, or queued with load_texture_async: the PNG is
+// decoded on a worker thread and uploaded later on the GL thread, either in batches
+// by upload_pending or on demand when something asks for it with get_texture.
+// If a texture pack is open, textures whose PNG still matches the pack's hash are
+// uploaded straight from the mapped pack instead of being decoded.
+//
+// Textures loaded with load_texture(_async) stay resident for the whole session.
+// Textures added with register_texture only get their size read up front; their
+// GL name exists from the start so Texture handles stay valid, but the pixels are
+// only uploaded while something holds a reference through acquire, and
+// evict_unreferenced frees the storage again once nothing does.
 
 class TextureManager {
 private:
-    std::unordered_map<std::string, Texture> textures_;
+    // a decoded image waiting for the GL thread, pixels is null if decoding failed
+    // packed images point into the mapped pack and aren't freed
+    struct DecodedImage {
+        std::string name;
+        std::string path;
+        int width, height;
+        const unsigned char* pixels;
+        bool packed;
+        bool stale; // the pack had this file but the PNG has changed since
+    };
+
+    struct AsyncLoader {
+        std::mutex mutex;
+        std::condition_variable decoded_ready;
+        std::deque<DecodedImage> decoded;
+        float decode_ms = 0.f;
+        std::unique_ptr<WorkerPool> workers;
+
+        AsyncLoader();
+        // joins the workers, then frees anything they decoded that was never uploaded
+        ~AsyncLoader();
+    };
+
+    struct TextureEntry {
+        std::string name;
+        std::string path;
+        Texture texture;
+        bool pinned;   // loaded eagerly, never evicted
+        bool resident; // pixels are on the GPU
+        int refs;
+    };
+
+    std::unordered_map<std::string, TextureEntry> textures_;
+    HandleTable<TextureEntry> handles_;
+
+    // created by the first async load, in_flight is only touched on the GL thread
+    std::unique_ptr<AsyncLoader> loader_;
+    std::unordered_set<std::string> in_flight_;
+    std::unique_ptr<TexturePack> pack_;
+    float upload_ms_;
+    size_t packed_count_, stale_count_;
+
+    // reads the PNG and takes its pixels from the pack if the hash matches, otherwise decodes it
+    // safe to call from worker threads
+    static DecodedImage decode(const TexturePack* pack, const std::string& name, const std::string& path);
+
+    static void free_pixels(DecodedImage& image);
+
+    TextureEntry& create_entry(const std::string& name, const std::string& path, bool pinned);
+
+    void queue_decode(const std::string& name, const std::string& path);
+
+    bool upload(TextureEntry& entry, int width, int height, const unsigned char* pixels);
+
+    void upload_decoded(DecodedImage& image);
+
+    static size_t texture_bytes(const TextureEntry& entry);
 
 public:
     TextureManager();
+    TextureManager(TextureManager&& other) = default;
     ~TextureManager();
 
+    // maps a pack written by texture_packer, returns false if it's missing or invalid
+    bool open_pack(const char* path);
+
     bool load_texture(const char* path, const char* name);
 
+    // queues the texture for decoding on a worker thread
+    // returns false if a texture with that name is already loaded or queued
+    bool load_texture_async(const char* path, const char* name);
+
+    // uploads up to max_uploads decoded textures without blocking, returns how many were uploaded
+    size_t upload_pending(size_t max_uploads);
+
+    // blocks until the named texture is uploaded, returns false if it failed or was never queued
+    bool wait_for(const char* name);
+
+    // blocks until every queued texture is uploaded
+    void finish_loading();
+
+    // adds an evictable texture without loading it, only its size is read
+    // returns false if the name is taken or the image can't be read
+    bool register_texture(const char* path, const char* name);
+
+    // takes a reference on each texture, queueing the ones that aren't resident
+    // use wait_for or finish_loading to block until they're uploaded
+    void acquire(const std::vector<std::string>& names);
+
+    void release(const std::vector<std::string>& names);
+
+    // frees the GPU storage of registered textures nobody references, returns the bytes freed
+    size_t evict_unreferenced();
+
+    bool is_resident(const std::string& name) const;
+
+    // bytes of GPU storage held by resident textures, of all of them or of the given ones
+    size_t resident_bytes() const;
+    size_t resident_bytes(const std::vector<std::string>& names) const;
+
+    // number of queued textures that aren't uploaded yet
+    size_t pending_count() const;
+
+    // prints the time spent decoding (summed over workers) and uploading, and pack usage
+    void print_load_stats();
+
+    // waits for the texture first if it is still being loaded asynchronously
     Texture get_texture(const char* name);
-};
\ No newline at end of file
+
+    // handles exist from load_texture(_async) or register_texture on, whether or not the
+    // texture is resident; INVALID_RESOURCE_HANDLE if there's no texture with that name
+    TextureHandle handle(ResourceName name) const;
+
+    Texture get_texture(TextureHandle handle);
+};
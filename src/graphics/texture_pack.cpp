@@ -0,0 +1,64 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#include <cstdio>
+#include <cstring>
+
+#include "texture_pack.h"
+
+bool TexturePack::open(const char* path) {
+    index_.clear();
+    if (!file_.open(path)) {
+        return false;
+    }
+
+    auto data = file_.data();
+    auto size = file_.size();
+    TexturePackHeader header;
+    if (size < sizeof(header)) {
+        fprintf(stderr, "Texture pack %s is truncated\n", path);
+        file_.close();
+        return false;
+    }
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, TEXTURE_PACK_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != TEXTURE_PACK_VERSION ||
+        sizeof(header) + header.count * sizeof(TexturePackEntry) > size) {
+        fprintf(stderr, "Texture pack %s has an unsupported format\n", path);
+        file_.close();
+        return false;
+    }
+
+    auto entries = (const TexturePackEntry*) (data + sizeof(header));
+    for (uint32_t i = 0; i < header.count; i++) {
+        auto& entry = entries[i];
+        bool in_bounds = entry.offset <= size && entry.size <= size - entry.offset &&
+                         entry.size == (uint64_t) entry.width * entry.height * 4;
+        if (!in_bounds || memchr(entry.file, '\0', sizeof(entry.file)) == nullptr) {
+            fprintf(stderr, "Texture pack %s has a corrupt entry\n", path);
+            index_.clear();
+            file_.close();
+            return false;
+        }
+        index_[entry.file] = &entry;
+    }
+    return true;
+}
+
+bool TexturePack::is_open() const {
+    return file_.is_open();
+}
+
+size_t TexturePack::size() const {
+    return index_.size();
+}
+
+const TexturePackEntry* TexturePack::find(const std::string& file) const {
+    auto it = index_.find(file);
+    return it == index_.end() ? nullptr : it->second;
+}
+
+const unsigned char* TexturePack::pixels(const TexturePackEntry& entry) const {
+    return file_.data() + entry.offset;
+}
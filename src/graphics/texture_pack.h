@@ -0,0 +1,58 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include "../util/mapped_file.h"
+
+// Binary pack of pre-decoded RGBA textures, written offline by tools/texture_packer
+//
+// Layout: a TexturePackHeader, then header.count TexturePackEntry records, then the
+// pixel data of each texture starting on a TEXTURE_PACK_ALIGNMENT boundary.
+// source_hash is hash_bytes of the PNG the pixels came from, so a pack entry is only
+// used while the PNG on disk is unchanged.
+
+static const char TEXTURE_PACK_MAGIC[4] = {'P', 'X', 'T', 'P'};
+static const uint32_t TEXTURE_PACK_VERSION = 1;
+static const uint64_t TEXTURE_PACK_ALIGNMENT = 4096;
+static const size_t TEXTURE_PACK_NAME_LENGTH = 64;
+
+struct TexturePackHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t count;
+    uint32_t reserved;
+};
+
+struct TexturePackEntry {
+    char file[TEXTURE_PACK_NAME_LENGTH]; // file name relative to data/textures, null terminated
+    uint64_t source_hash;
+    uint32_t width, height;
+    uint64_t offset; // from the start of the pack
+    uint64_t size;
+};
+
+// Read-only view of a memory-mapped texture pack
+class TexturePack {
+private:
+    MappedFile file_;
+    std::unordered_map<std::string, const TexturePackEntry*> index_;
+
+public:
+    // maps the pack and validates its header and entries
+    bool open(const char* path);
+
+    bool is_open() const;
+
+    size_t size() const;
+
+    // returns nullptr if the file isn't in the pack
+    const TexturePackEntry* find(const std::string& file) const;
+
+    const unsigned char* pixels(const TexturePackEntry& entry) const;
+};
@@ -6,6 +6,7 @@
 
 #include "window.h"
 #include "camera.h"
+#include <algorithm>
 
 Window::~Window()
 {
@@ -89,6 +90,7 @@ void Window::destroy() {
 }
 
 void Window::clear() {
+    clear_color_ = {0.f, 0.f, 0.f};
     glClearColor(0, 0, 0, 1);
     glClear(GL_COLOR_BUFFER_BIT);
     framebuffer_->bind();
@@ -97,20 +99,49 @@ void Window::clear() {
     framebuffer_->unbind();
 }
 
-void Window::display(Shader shader, Mesh mesh) {
+void Window::display(const PostProcessChain& chain, Shader base_shader, Mesh mesh) {
     framebuffer_->test();
 
-    auto fb_texture = framebuffer_->get_texture();
-
-    auto sprite = Sprite(fb_texture, shader, mesh);
-    sprite.set_size(width_, height_);
-    sprite.set_scale(1, -1);
-    sprite.set_pos(0, 0);
+    auto input = framebuffer_->get_texture();
+    auto full = input; // last full scale image, bound to sampler1
 
     auto null_camera = Camera(width_, height_, 0, 0);
     null_camera.compose();
+    auto projection = null_camera.get_projection();
+
+    auto& passes = chain.passes();
+    bool presented = false;
+    for (size_t i = 0; i < passes.size(); i++) {
+        auto& pass = passes[i];
+        auto source = pass.input == FULL_SCALE_INPUT ? full : input;
+
+        if (i + 1 == passes.size() && pass.scale == FULL_SCALE) {
+            // the last full scale pass goes straight to the back buffer
+            glViewport(0, 0, width_, height_);
+            draw_pass(source, full, pass.shader, mesh, projection);
+            presented = true;
+            break;
+        }
+
+        auto target = pass_target(pass.scale, source, full);
+        target->bind();
+        glViewport(0, 0, target->width(), target->height());
+        glClearColor(0, 0, 0, 1);
+        glClear(GL_COLOR_BUFFER_BIT);
+        draw_pass(source, full, pass.shader, mesh, projection);
+        target->unbind();
+
+        input = target->get_texture();
+        if (pass.scale == FULL_SCALE) {
+            full = input;
+        }
+    }
 
-    sprite.draw(null_camera.get_projection());
+    // a chain ending below full scale is scaled back up by the copy to the back buffer
+    glViewport(0, 0, width_, height_);
+    if (!presented) {
+        draw_pass(input, full, base_shader, mesh, projection);
+    }
 
     SDL_GL_SwapWindow(sdl_window_);
 
@@ -119,6 +150,43 @@ void Window::display(Shader shader, Mesh mesh) {
     delta_time_ = ((recent_time_ - last_time_) / (float)SDL_GetPerformanceFrequency());
 }
 
+Framebuffer* Window::pass_target(PassScale scale, Texture source, Texture full) {
+    auto& buffers = pass_buffers_[scale];
+    for (auto& buffer : buffers) {
+        if (!buffer) {
+            buffer = std::make_unique<Framebuffer>(
+                std::max(1, width_ / (int) scale),
+                std::max(1, height_ / (int) scale)
+            );
+        }
+        auto id = buffer->get_texture().id();
+        if (id != source.id() && id != full.id()) {
+            return buffer.get();
+        }
+    }
+    return buffers[0].get();
+}
+
+void Window::draw_pass(Texture source, Texture full, Shader shader, Mesh mesh, const mat3& projection) {
+    shader.bind();
+    shader.set_uniform_int("sampler1", 1);
+    shader.unbind();
+
+    glActiveTexture(GL_TEXTURE1);
+    full.bind();
+
+    // sizes are in window pixels, the viewport takes care of the pass scale
+    auto sprite = Sprite(source, shader, mesh);
+    sprite.set_size(width_, height_);
+    sprite.set_scale(1, -1);
+    sprite.set_pos(0, 0);
+    sprite.draw(projection);
+
+    glActiveTexture(GL_TEXTURE1);
+    full.unbind();
+    glActiveTexture(GL_TEXTURE0);
+}
+
 float Window::delta_time() {
     return delta_time_;
 }
@@ -135,8 +203,13 @@ vec2 Window::size() {
 }
 
 void Window::colorScreen(vec3 color) {
+    clear_color_ = {color.x / 256.f, color.y / 256.f, color.z / 256.f};
     framebuffer_->bind();
-    glClearColor(color.x / 256.f, color.y / 256.f, color.z / 256.f, 1);
+    glClearColor(clear_color_.x, clear_color_.y, clear_color_.z, 1);
     glClear(GL_COLOR_BUFFER_BIT);
     framebuffer_->unbind();
 }
+
+vec3 Window::clear_color() {
+    return clear_color_;
+}
@@ -9,7 +9,10 @@
 #include "render.h"
 #include "sprite.h"
 #include "framebuffer.h"
+#include "post_process_chain.h"
+#include <array>
 #include <memory>
+#include <unordered_map>
 
 // Wrap SDL calls with a window creation/management class
 class Window : public RenderTarget {
@@ -19,9 +22,20 @@ private:
     uint64_t last_time_, recent_time_;
     int width_, height_;
     float delta_time_ = 0;
+    vec3 clear_color_ = {0.f, 0.f, 0.f};
     int WINDOWED_WIDTH = 800;
     int WINDOWED_HEIGHT = 450;
     std::unique_ptr<Framebuffer> framebuffer_;
+    // ping-pong intermediates for post-processing, keyed by PassScale and created when a chain
+    // first needs them. A third buffer per scale covers a pass that writes while the last full
+    // scale image and its own source are both still bound.
+    std::unordered_map<int, std::array<std::unique_ptr<Framebuffer>, 3>> pass_buffers_;
+
+    // returns an intermediate buffer at the given scale that is neither the source nor full
+    Framebuffer* pass_target(PassScale scale, Texture source, Texture full);
+
+    // draws source over the whole of the currently bound buffer, with full bound to sampler1
+    void draw_pass(Texture source, Texture full, Shader shader, Mesh mesh, const mat3& projection);
 
 public:
     Window(const char* title);
@@ -36,9 +50,11 @@ public:
     // clears the window
     void clear();
 
-    // renders the internal buffer to the back buffer using the given shader
+    // runs the internal buffer through the post-process chain into the back buffer
     // then swaps the back buffers and displays what's been drawn
-    void display(Shader shader, Mesh mesh);
+    // base_shader is used to copy to the back buffer when the chain is empty or
+    // its last pass renders below full scale
+    void display(const PostProcessChain& chain, Shader base_shader, Mesh mesh);
 
     // returns the time elapsed between the last 2 display() calls, in seconds
     float delta_time();
@@ -50,4 +66,7 @@ public:
 
     void colorScreen(vec3 color);
 
+    // the colour the internal buffer was last cleared to, in [0, 1]
+    vec3 clear_color();
+
 };
\ No newline at end of file
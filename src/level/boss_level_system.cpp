@@ -3,23 +3,24 @@
 //
 
 #include <util/constants.h>
-#include <util/csv_reader.h>
 #include <components/transform.h>
 #include <components/collidable.h>
 #include <components/timer.h>
 #include "boss_level_system.h"
 
 
-
-void BossLevelSystem::init(entt::DefaultRegistry &registry)  {
-    LevelSystem::init(registry);
-
+BossLevelSystem::BossLevelSystem(bool dracula) :
+    dracula(dracula)
+{
     if(dracula){
-        level_ = Level::load_from_path("dracula_level.csv");
+        level_ = SpawnList::columns(Level::load_from_path("dracula_level.csv"));
     }else{
-        level_ = Level::load_from_path("jacko_level.csv");
+        level_ = SpawnList::columns(Level::load_from_path("jacko_level.csv"));
     }
+}
 
+void BossLevelSystem::init(entt::DefaultRegistry &registry)  {
+    LevelSystem::init(registry);
 
     generated_ = false;
 }
@@ -32,12 +33,11 @@ void BossLevelSystem::update(Blackboard &blackboard, entt::DefaultRegistry &regi
 }
 
 void BossLevelSystem::generate_level(Blackboard &blackboard, entt::DefaultRegistry &registry) {
-    for (size_t i = 0; i < level_.width(); i++) {
-        float x = FIRST_COL_X + (float) CELL_WIDTH * i;
-        for (size_t j = 0; j < level_.height(); j++) {
-            float y = FIRST_ROW_Y + (float) CELL_HEIGHT * j;
-
-            generateEntity(level_.get_tile_at(i, j), x, y, blackboard, registry, STORY_EASY);
-        }
+    // the arena is spawned once, so it's prepared right here instead of on the worker
+    PreparedChunk chunk = prepare_chunk(0, level_, rng_);
+    for (auto &record : chunk.records) {
+        float x = FIRST_COL_X + (float) CELL_WIDTH * record.line;
+        float y = FIRST_ROW_Y + (float) CELL_HEIGHT * record.offset;
+        generateEntity(record, x, y, blackboard, registry, STORY_EASY);
     }
 }
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "level/level_system.h"
 #include "scene/scene_mode.h"
 #include "level.h"
+#include "spawn_list.h"
 
 class BossLevelSystem : public LevelSystem {
 private:
@@ -16,13 +17,13 @@ private:
 
     const float FIRST_COL_X = -800.f;
     const float FIRST_ROW_Y = -400.f;
-    Level level_;
+    SpawnList level_;
     bool generated_;
     bool dracula;
 
 public:
 
-    BossLevelSystem(bool dracula): dracula(dracula){};
+    BossLevelSystem(bool dracula);
 
     void init(entt::DefaultRegistry &registry) override;
 
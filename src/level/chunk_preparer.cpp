@@ -0,0 +1,90 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include "chunk_preparer.h"
+
+ChunkPreparer::ChunkPreparer() :
+        requested_(0),
+        running_(0),
+        generation_(0),
+        taken_(0),
+        reported_taken_(0),
+        stalls_(0),
+        stall_ms_(0) {
+}
+
+void ChunkPreparer::request(Job job) {
+    if (!worker_) {
+        worker_.reset(new WorkerPool(1));
+    }
+    uint32_t generation;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        requested_++;
+        running_++;
+        generation = generation_;
+    }
+    worker_->submit([this, job, generation]() {
+        bool current;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            current = generation == generation_;
+        }
+        PreparedChunk chunk;
+        if (current) {
+            chunk = job();
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (current && generation == generation_) {
+                ready_.push_back(std::move(chunk));
+            }
+            running_--;
+        }
+        finished_.notify_all();
+    });
+}
+
+PreparedChunk ChunkPreparer::take() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    assert(requested_ > 0);
+    if (ready_.empty()) {
+        auto start = std::chrono::steady_clock::now();
+        finished_.wait(lock, [this] { return !ready_.empty(); });
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        stalls_++;
+        stall_ms_ += elapsed.count();
+    }
+    PreparedChunk chunk = std::move(ready_.front());
+    ready_.pop_front();
+    requested_--;
+    taken_++;
+    return chunk;
+}
+
+size_t ChunkPreparer::pending() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return requested_;
+}
+
+void ChunkPreparer::cancel() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    generation_++;
+    finished_.wait(lock, [this] { return running_ == 0; });
+    ready_.clear();
+    requested_ = 0;
+}
+
+void ChunkPreparer::print_stats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (taken_ == reported_taken_) {
+        return;
+    }
+    reported_taken_ = taken_;
+    printf("chunks: %zu prepared in the background, %zu stalls waiting on the worker (%.2fms)\n",
+           taken_, stalls_, stall_ms_);
+}
@@ -0,0 +1,95 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#ifndef PANDAEXPRESS_CHUNK_PREPARER_H
+#define PANDAEXPRESS_CHUNK_PREPARER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "util/worker_pool.h"
+
+// One entity to spawn, line and offset are cell indices along and across the streaming direction
+// and variant is the already rolled texture choice for prefabs that have more than one
+struct SpawnRecord {
+    uint32_t line;
+    uint32_t offset;
+    char tile;
+    uint8_t variant;
+};
+
+// Command buffer for one chunk, records are sorted by line
+struct PreparedChunk {
+    int level;
+    uint32_t lines;
+    std::vector<SpawnRecord> records;
+};
+
+// Streaming position in a prepared chunk, next_record is the first record of line
+struct ChunkCursor {
+    PreparedChunk chunk;
+    size_t line;
+    size_t next_record;
+
+    bool done() const { return line >= chunk.lines; }
+
+    // records left on the current line
+    size_t line_records() const {
+        size_t end = next_record;
+        while (end < chunk.records.size() && chunk.records[end].line == line) {
+            end++;
+        }
+        return end - next_record;
+    }
+};
+
+// Prepares chunks on a background thread ahead of the camera, the main thread only takes the
+// finished command buffers and commits them to the registry. Jobs run one at a time in request
+// order, so state only touched by jobs needs no locking of its own.
+class ChunkPreparer {
+public:
+    typedef std::function<PreparedChunk()> Job;
+
+    ChunkPreparer();
+
+    ChunkPreparer(const ChunkPreparer&) = delete;
+    ChunkPreparer& operator=(const ChunkPreparer&) = delete;
+
+    void request(Job job);
+
+    // the oldest requested chunk, blocks if the worker hasn't finished it yet
+    PreparedChunk take();
+
+    // chunks requested and not taken yet
+    size_t pending();
+
+    // waits for running jobs and discards every chunk not taken yet,
+    // jobs can't touch shared state once this returns
+    void cancel();
+
+    // prints how often take() had to wait, only if chunks were taken since the last report
+    void print_stats();
+
+private:
+    std::mutex mutex_;
+    std::condition_variable finished_;
+    std::deque<PreparedChunk> ready_;
+    size_t requested_; // requested and not taken or cancelled
+    size_t running_; // submitted to the worker and not finished, cancelled ones included
+    uint32_t generation_; // bumped by cancel, jobs from older generations are skipped
+
+    size_t taken_;
+    size_t reported_taken_;
+    size_t stalls_;
+    double stall_ms_;
+
+    std::unique_ptr<WorkerPool> worker_; // started on the first request, declared last so it joins first
+};
+
+#endif //PANDAEXPRESS_CHUNK_PREPARER_H
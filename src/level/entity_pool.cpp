@@ -0,0 +1,133 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <components/bread.h>
+#include <components/causes_damage.h>
+#include <components/chunk_member.h>
+#include <components/collidable.h>
+#include <components/food.h>
+#include <components/ghost.h>
+#include <components/health.h>
+#include <components/interactable.h>
+#include <components/layer.h>
+#include <components/llama.h>
+#include <components/obeys_gravity.h>
+#include <components/obstacle.h>
+#include <components/platform.h>
+#include <components/pooled.h>
+#include <components/powerup.h>
+#include <components/spit.h>
+#include <components/static.h>
+#include <components/timer.h>
+#include <components/transform.h>
+#include <components/velocity.h>
+#include "entity_pool.h"
+
+// texture variants of each prefab, spawns pick one at random where there are two
+static const char* PREFAB_TEXTURES[PREFAB_COUNT][2] = {
+        {"platform1",        "platform2"},        // ONE_WAY_PLATFORM_PREFAB
+        {"solid_block_1",    "solid_block_2"},    // SOLID_PLATFORM_PREFAB
+        {"bread",            nullptr},            // BREAD_PREFAB
+        {"ghost",            nullptr},            // GHOST_PREFAB
+        {"llama",            nullptr},            // LLAMA_PREFAB
+        {"stalagmite",       nullptr},            // SPIKE_PREFAB
+        {"falling_blocks_1", "falling_blocks_2"}, // FALLING_PLATFORM_PREFAB
+        {"burger",           nullptr},            // FOOD_PREFAB
+        {"shield",           nullptr},            // SHIELD_PREFAB
+        {"vial",             nullptr},            // VIAL_PREFAB
+        {"dirt_1",           "dirt_2"},           // DIRT_PREFAB
+        {"grass_1",          "grass_2"},          // GRASS_PREFAB
+        {"spit",             nullptr},            // SPIT_PREFAB
+};
+
+// removes every component a pooled entity can be given, by its spawn or by other systems
+template<typename... Component>
+static void strip(entt::DefaultRegistry &registry, uint32_t entity) {
+    using expand = int[];
+    (void) expand{0, (registry.reset<Component>(entity), 0)...};
+}
+
+EntityPool::EntityPool() :
+        prefabs_(),
+        free_(),
+        created_(0),
+        reused_(0),
+        parked_(0),
+        destroyed_(0),
+        spawns_(0),
+        reported_spawns_(0),
+        spawn_ms_(0) {}
+
+Prefab& EntityPool::prefab(PrefabID id, Blackboard &blackboard) {
+    auto& prefab = prefabs_[id];
+    if (!prefab.resolved()) {
+        auto shader = blackboard.shader_manager.get_shader(blackboard.shader_manager.handle(SPRITE_SHADER));
+        auto mesh = blackboard.mesh_manager.get_mesh(blackboard.mesh_manager.handle(SPRITE_MESH));
+        for (auto name : PREFAB_TEXTURES[id]) {
+            if (name != nullptr) {
+                auto texture = blackboard.texture_manager.get_texture(name);
+                prefab.textures.push_back(texture);
+                prefab.sprites.emplace_back(texture, shader, mesh);
+            }
+        }
+    }
+    return prefab;
+}
+
+uint32_t EntityPool::acquire(entt::DefaultRegistry &registry, PrefabID id) {
+    auto& free = free_[id];
+    uint32_t entity;
+    // parked ids are dropped if something destroyed them behind the pool's back
+    while (!free.empty() && !registry.valid(free.back())) {
+        free.pop_back();
+    }
+    if (free.empty()) {
+        entity = registry.create();
+        created_++;
+    } else {
+        entity = free.back();
+        free.pop_back();
+        reused_++;
+    }
+    registry.assign<Pooled>(entity, id);
+    return entity;
+}
+
+void EntityPool::despawn(entt::DefaultRegistry &registry, uint32_t entity) {
+    if (!registry.has<Pooled>(entity)) {
+        registry.destroy(entity);
+        destroyed_++;
+        return;
+    }
+
+    PrefabID id = registry.get<Pooled>(entity).prefab;
+    strip<Transform, Sprite, Collidable, Layer, Velocity, Interactable, ObeysGravity, Timer, Health,
+          CausesDamage, Platform, Obstacle, Static, Bread, Ghost, Llama, Spit, Food, Powerup, ChunkMember, Pooled>(registry, entity);
+    assert(registry.orphan(entity));
+    free_[id].push_back(entity);
+    parked_++;
+}
+
+void EntityPool::record_spawn(double ms) {
+    spawns_++;
+    spawn_ms_ += ms;
+}
+
+void EntityPool::print_stats() {
+    if (spawns_ == reported_spawns_) {
+        return;
+    }
+    reported_spawns_ = spawns_;
+
+    size_t parked = 0;
+    for (auto& free : free_) {
+        parked += free.size();
+    }
+    printf("entities: %zu created, %zu reused (creates avoided), %zu parked, %zu destroyed, %zu waiting\n",
+           created_, reused_, parked_, destroyed_, parked);
+    printf("entities: %zu spawns, %.2fus per spawn\n", spawns_, spawn_ms_ * 1000 / spawns_);
+}
@@ -0,0 +1,54 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#ifndef PANDAEXPRESS_ENTITY_POOL_H
+#define PANDAEXPRESS_ENTITY_POOL_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include <entt/entity/registry.hpp>
+#include <util/blackboard.h>
+#include "prefab.h"
+
+// Prefabs and free lists for the entities levels spawn and despawn in bulk
+//
+// Despawning a pooled entity strips its components and parks its id in its prefab's free
+// list, and the next spawn of that prefab reuses it. Component storage never shrinks,
+// so a reused entity is rebuilt in memory the registry already has.
+class EntityPool {
+private:
+    std::array<Prefab, PREFAB_COUNT> prefabs_;
+    std::array<std::vector<uint32_t>, PREFAB_COUNT> free_;
+
+    size_t created_, reused_, parked_, destroyed_;
+    size_t spawns_, reported_spawns_;
+    double spawn_ms_;
+
+public:
+    EntityPool();
+
+    // resolves the prefab's textures, shader and mesh the first time it is used
+    Prefab& prefab(PrefabID id, Blackboard &blackboard);
+
+    // an entity with only a Pooled component, reused from the free list when there is one
+    uint32_t acquire(entt::DefaultRegistry &registry, PrefabID id);
+
+    // parks pooled entities and destroys everything else
+    void despawn(entt::DefaultRegistry &registry, uint32_t entity);
+
+    template<typename Component>
+    void despawn_all(entt::DefaultRegistry &registry) {
+        for (auto entity : registry.view<Component>()) {
+            despawn(registry, entity);
+        }
+    }
+
+    void record_spawn(double ms);
+
+    // prints counts and average spawn cost, if anything spawned since the last report
+    void print_stats();
+};
+
+#endif //PANDAEXPRESS_ENTITY_POOL_H
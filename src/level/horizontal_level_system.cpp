@@ -11,20 +11,25 @@
 
 HorizontalLevelSystem::HorizontalLevelSystem() :
         LevelSystem(),
-        mode_(ENDLESS),
         min_difficulty(MIN_DIFFICULTY_EASY),
         max_difficulty(MAX_DIFFICULTY_HARD),
-        difficulty_range(DIFFICULTY_RANGE_ENDLESS)
+        difficulty_range(DIFFICULTY_RANGE_ENDLESS),
+        mode_(ENDLESS),
+        prepared_(false)
 {
     for (int i = 0; i <= MAX_DIFFICULTY_HARD; i++) {
-        levels[i] = Level::load_level(i, HORIZONTAL_LEVEL_TYPE);
+        levels[i] = SpawnList::columns(Level::load_level(i, HORIZONTAL_LEVEL_TYPE));
     }
 
-    levels[END_LEVEL] = Level::load_level(END_LEVEL, HORIZONTAL_LEVEL_TYPE);
+    levels[END_LEVEL] = SpawnList::columns(Level::load_level(END_LEVEL, HORIZONTAL_LEVEL_TYPE));
 }
 
-void HorizontalLevelSystem::init(SceneMode mode, entt::DefaultRegistry &registry) {
-    LevelSystem::init(registry);
+HorizontalLevelSystem::~HorizontalLevelSystem() {
+    preparer_.cancel();
+}
+
+void HorizontalLevelSystem::prepare(SceneMode mode) {
+    cancel_chunks();
 
     mode_ = mode;
     if (mode_ == ENDLESS) {
@@ -43,28 +48,73 @@ void HorizontalLevelSystem::init(SceneMode mode, entt::DefaultRegistry &registry
         max_difficulty = MAX_DIFFICULTY_HARD;
         difficulty_range = DIFFICULTY_RANGE_STORY;
     }
+    variant_rng_.init(0);
+
+    difficulty = min_difficulty;
+    request_chunk(0);
+    // the chunks init() would have topped up with right after taking the first one
+    for (size_t i = 0; i < PREPARE_AHEAD; i++) {
+        request_chunk();
+    }
+    prepared_ = true;
+}
+
+void HorizontalLevelSystem::init(SceneMode mode, entt::DefaultRegistry &registry) {
+    if (!prepared_ || mode_ != mode) {
+        prepare(mode);
+    }
+    prepared_ = false;
+    destroy_entities(registry);
 
     last_col_generated_ = last_col_loaded_ = FIRST_COL_X;
     difficulty = min_difficulty;
     difficulty_timer.save_watch(LEVEL_UP_LABEL, LEVEL_UP_INTERVAL);
-    load_next_chunk(0);
+    load_next_chunk();
 }
 
-void HorizontalLevelSystem::load_next_chunk() {
-    int level = rng_.nextInt(std::max(1, difficulty - difficulty_range), difficulty);
-    load_next_chunk(level);
+void HorizontalLevelSystem::request_chunk() {
+    queue_chunk(chunk_request(-1));
 }
 
-void HorizontalLevelSystem::load_next_chunk(int id) {
-    Level lvl = levels[id];
-    for (int x = 0; x < lvl.width(); x++) {
-        std::vector<char> col;
-        col.reserve(lvl.height());
-        for (int y = 0; y < lvl.height(); y++) {
-            col.push_back(lvl.get_tile_at(x, y));
-        }
-        last_col_loaded_ += CELL_WIDTH;
-        chunks_.push(col);
+void HorizontalLevelSystem::request_chunk(int id) {
+    queue_chunk(chunk_request(id));
+}
+
+void HorizontalLevelSystem::queue_chunk(ChunkRequest request) {
+    // difficulty is read now, requeue_chunks() prepares the chunk again when it goes up
+    int low = std::max(1, difficulty - difficulty_range);
+    int high = difficulty;
+    if (request.random) {
+        // picked here rather than on the worker, in the order the chunks are loaded
+        request.picker = rng_;
+        request.level = rng_.nextInt(low, high);
+    }
+    requests_.push_back(request);
+    int level = request.level;
+    unsigned int seed = request.seed;
+    preparer_.request([this, level, seed]() {
+        Random rng(seed);
+        return prepare_chunk(level, levels.at(level), rng);
+    });
+}
+
+void HorizontalLevelSystem::requeue_chunks() {
+    std::deque<ChunkRequest> queued = requests_;
+    cancel_chunks(); // rewinds rng_, the random chunks are picked again from the new range
+    for (auto &request : queued) {
+        queue_chunk(request);
+    }
+}
+
+void HorizontalLevelSystem::load_next_chunk() {
+    PreparedChunk chunk = preparer_.take();
+    requests_.pop_front();
+    last_col_loaded_ += CELL_WIDTH * chunk.lines;
+    if (chunk.lines > 0) {
+        chunks_.push_back({std::move(chunk), 0, 0});
+    }
+    while (preparer_.pending() < PREPARE_AHEAD) {
+        request_chunk();
     }
 }
 
@@ -72,21 +122,39 @@ void HorizontalLevelSystem::load_next_chunk(int id) {
 
 void HorizontalLevelSystem::generate_next_chunk(Blackboard &blackboard,
                                                 entt::DefaultRegistry &registry) {
+    // columns up to half a screen past the right edge are generated ahead of time within the frame's
+    // budget, the ones inside the safety margin are generated whatever it costs
     float off_screen = blackboard.camera.position().x + blackboard.camera.size().x;
+    float margin = blackboard.camera.position().x + blackboard.camera.size().x / 2 +
+                   (float) CELL_WIDTH * SPAWN_SAFETY_LINES;
+    reset_spawn_budget();
     while (last_col_generated_ < off_screen && !chunks_.empty()) { // second condn is safety check
-        std::vector<char> col = chunks_.front();
-        float y = -400.0f;
-        for (int c:col) {
-            generateEntity(c, last_col_generated_, y, blackboard, registry, mode_);
-            y += CELL_HEIGHT;
+        ChunkCursor &cursor = chunks_.front();
+        if (!spend_spawn_budget(cursor, last_col_generated_ < margin)) {
+            break;
+        }
+        if (cursor.line == 0) {
+            begin_chunk();
         }
+        auto &records = cursor.chunk.records;
+        for (; cursor.next_record < records.size() && records[cursor.next_record].line == cursor.line;
+               cursor.next_record++) {
+            auto &record = records[cursor.next_record];
+            float y = FIRST_ROW_Y + (float) CELL_HEIGHT * record.offset;
+            generateEntity(record, last_col_generated_, y, blackboard, registry, mode_);
+        }
+        live_chunks_.back().last_line = last_col_generated_;
         last_col_generated_ += CELL_WIDTH;
-        chunks_.pop();
+        cursor.line++;
+        if (cursor.done()) {
+            live_chunks_.back().complete = true;
+            chunks_.pop_front();
+        }
     }
 }
 
 void HorizontalLevelSystem::destroy_entities(entt::DefaultRegistry &registry) {
-    registry.destroy<Spit>(); // Destroy Spit here since it was not generated by LevelSystem
+    pool_.despawn_all<Spit>(registry); // Destroy Spit here since it was not generated by LevelSystem
     LevelSystem::destroy_entities(registry);
 }
 
@@ -104,6 +172,7 @@ void HorizontalLevelSystem::update(Blackboard &blackboard, entt::DefaultRegistry
     if (difficulty < max_difficulty && difficulty_timer.is_done(LEVEL_UP_LABEL)) {
         difficulty++;
         difficulty_timer.reset_watch(LEVEL_UP_LABEL);
+        requeue_chunks();
     }
 
     destroy_off_screen(registry, min_x);
@@ -111,55 +180,13 @@ void HorizontalLevelSystem::update(Blackboard &blackboard, entt::DefaultRegistry
 }
 
 void HorizontalLevelSystem::destroy_off_screen(entt::DefaultRegistry &registry, float x) {
-    auto platforms = registry.view<Platform, Transform>();
-    for (uint32_t entity: platforms) {
-        auto &transform = platforms.get<Transform>(entity);
-        if (transform.x < x) {
-            registry.destroy(entity);
-        }
-    }
-
-    auto llamas = registry.view<Llama, Transform>();
-    for (uint32_t entity: llamas) {
-        auto &transform = llamas.get<Transform>(entity);
-        if (transform.x < x) {
-            registry.destroy(entity);
-        }
-    }
-
-    auto spits = registry.view<Spit, Transform>();
-    for (uint32_t entity: spits) {
-        auto &transform = spits.get<Transform>(entity);
-        if (transform.x < x) {
-            registry.destroy(entity);
-        }
-    }
-
-    auto breads = registry.view<Bread, Transform>();
-    for (uint32_t entity: breads) {
-        auto &transform = breads.get<Transform>(entity);
-        if (transform.x < x) {
-            registry.destroy(entity);
-        }
-    }
-
-    auto ghosts = registry.view<Ghost, Transform>();
-    for (uint32_t entity: ghosts) {
-        auto &transform = ghosts.get<Transform>(entity);
-        if (transform.x < x) {
-            registry.destroy(entity);
-        }
-    }
-
-    auto obstacles = registry.view<Obstacle, Transform>();
-    for (uint32_t entity: obstacles) {
-        auto &transform = obstacles.get<Transform>(entity);
-        if (transform.x < x) {
-            registry.destroy(entity);
-        }
-    }
+    // enemies and spit that leave the screen earlier are despawned by the EnemySystem
+    retire_chunks(registry, &Transform::x, [x](float col) { return col < x; });
 }
 
 void HorizontalLevelSystem::generate_end_level() {
-    load_next_chunk(END_LEVEL);
+    // drop the random chunks prepared ahead so the end level comes next
+    cancel_chunks();
+    request_chunk(END_LEVEL);
+    load_next_chunk();
 }
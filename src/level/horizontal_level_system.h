@@ -4,20 +4,30 @@
 #include "level_system.h"
 #include "components/timer.h"
 #include "level.h"
+#include "spawn_list.h"
 
 #ifndef PANDAEXPRESS_HORIZONTAL_LEVEL_SYSTEM_H
 #define PANDAEXPRESS_HORIZONTAL_LEVEL_SYSTEM_H
 
 class HorizontalLevelSystem : public LevelSystem {
 private:
+    // takes the next prepared chunk and keeps PREPARE_AHEAD more in preparation
     void load_next_chunk();
-    void load_next_chunk(int id);
+
+    // prepares a random level of the current difficulty
+    void request_chunk();
+    void request_chunk(int id);
+    void queue_chunk(ChunkRequest request);
+
+    // the queued chunks were rolled for the old difficulty, prepares them again with their seeds
+    void requeue_chunks();
 
     void generate_next_chunk(Blackboard &blackboard, entt::DefaultRegistry &registry);
 
     void destroy_off_screen(entt::DefaultRegistry &registry, float x);
 
     const float FIRST_COL_X = -200;
+    const float FIRST_ROW_Y = -400.f;
     const int MIN_DIFFICULTY_EASY = 3;
     const int MAX_DIFFICULTY_EASY = 10;
     const int MIN_DIFFICULTY_HARD = 14;
@@ -25,7 +35,7 @@ private:
     const int DIFFICULTY_RANGE_STORY = 2;
     const int DIFFICULTY_RANGE_ENDLESS = 7;
     const float LEVEL_UP_INTERVAL = 5;
-    const std::string LEVEL_UP_LABEL = "level_up";
+    const TimerLabel LEVEL_UP_LABEL = Timer::label("level_up");
 
     const int END_LEVEL = 50;
 
@@ -40,12 +50,20 @@ private:
     Timer difficulty_timer;
 
     SceneMode mode_;
-    std::unordered_map<int, Level> levels;
+    bool prepared_;
+    std::unordered_map<int, SpawnList> levels;
 
 public:
 
     HorizontalLevelSystem();
 
+    // prepare jobs read levels, so they have to finish before it's destroyed
+    ~HorizontalLevelSystem();
+
+    // seeds the level and queues its first chunks without touching the registry, so it can run
+    // while another scene is still playing; init() with the same mode then starts without waiting
+    void prepare(SceneMode mode);
+
     void init(SceneMode mode, entt::DefaultRegistry &registry);
 
     void update(Blackboard &blackboard, entt::DefaultRegistry &registry) override;
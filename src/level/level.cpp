@@ -6,18 +6,29 @@
 #include <string>
 #include <util/constants.h>
 #include <util/csv_reader.h>
+#include <util/hash.h>
 #include "level.h"
 
-Level::Level() : width_(0), height_(0), rows_() {}
+Level::Level() : owned_(), tiles_(nullptr), width_(0), height_(0) {}
 
-char Level::get_tile_at(int x, int y) const {
-    if (y >= rows_.size())
-        return '\0';
+LevelPack& Level::pack() {
+    static LevelPack pack;
+    return pack;
+}
 
-    if (x >= rows_[y].size())
+bool Level::open_pack(const char* path) {
+    if (!pack().open(path)) {
+        return false;
+    }
+    printf("levels: using pack %s with %zu levels\n", path, pack().size());
+    return true;
+}
+
+char Level::get_tile_at(int x, int y) const {
+    if (x < 0 || y < 0 || (size_t) y >= height_ || (size_t) x >= width_)
         return '\0';
 
-    return rows_[y][x];
+    return tiles_[y * width_ + x];
 }
 
 Level Level::load_level(int id, LevelType type) {
@@ -38,21 +49,54 @@ Level Level::load_level(int id, LevelType type) {
     }
 }
 
+static bool read_file(const std::string& path, std::vector<unsigned char>& bytes) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    bytes.resize(size > 0 ? (size_t) size : 0);
+    bool ok = fread(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    fclose(file);
+    return ok;
+}
+
 Level Level::load_from_path(std::string file_name) {
-    CSVReader reader(levels_path("") + file_name);
-    auto data = reader.getData();
+    std::string path = levels_path("") + file_name;
 
     Level level;
-    level.height_ = data.size();
+    auto entry = pack().find(file_name);
+    if (entry != nullptr) {
+        // the CSV is still read to catch edits made since the pack was built, but not parsed
+        std::vector<unsigned char> bytes;
+        bool has_source = read_file(path, bytes);
+        if (!has_source || hash_bytes(bytes.data(), bytes.size()) == entry->source_hash) {
+            level.tiles_ = pack().tiles(*entry);
+            level.width_ = entry->width;
+            level.height_ = entry->height;
+            return level;
+        }
+        printf("levels: %s changed since the level pack was built, parsing it\n", file_name.c_str());
+    }
 
-    int y = 0;
+    CSVReader reader(path);
+    auto data = reader.getData();
+
+    level.height_ = data.size();
     for (const auto &row : data) {
-        level.rows_.push_back(row);
         if (level.width_ < row.size())
             level.width_ = row.size();
+    }
 
-        y++;
+    // short rows are padded with '\0', same as reading past their end
+    auto tiles = std::make_shared<std::vector<char>>(level.width_ * level.height_, '\0');
+    for (size_t y = 0; y < data.size(); y++) {
+        std::copy(data[y].begin(), data[y].end(), tiles->begin() + y * level.width_);
     }
+    level.tiles_ = tiles->data();
+    level.owned_ = tiles;
 
     return level;
 }
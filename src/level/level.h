@@ -5,8 +5,12 @@
 #ifndef PANDAEXPRESS_LEVEL_H
 #define PANDAEXPRESS_LEVEL_H
 
+#include <memory>
+#include <string>
 #include <vector>
 
+#include "level_pack.h"
+
 typedef unsigned int LevelType;
 const LevelType HORIZONTAL_LEVEL_TYPE = 0;
 const LevelType VERTICAL_LEVEL_TYPE = 1;
@@ -14,10 +18,16 @@ const LevelType VERTICAL_LEVEL_TYPE = 1;
 class Level {
 private:
 
-    std::vector<std::vector<char>> rows_;
+    // row-major tiles, either parsed from a CSV into owned_ or pointing into the level pack
+    std::shared_ptr<const std::vector<char>> owned_;
+    const char* tiles_;
     size_t width_, height_;
 
+    static LevelPack& pack();
+
 public:
+    // levels found in the pack are read from it instead of parsing their CSV
+    static bool open_pack(const char* path);
     static Level load_level(int id, LevelType type);
     static Level load_from_path(std::string file_name);
     Level();
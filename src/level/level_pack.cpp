@@ -0,0 +1,64 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#include <cstdio>
+#include <cstring>
+
+#include "level_pack.h"
+
+bool LevelPack::open(const char* path) {
+    index_.clear();
+    if (!file_.open(path)) {
+        return false;
+    }
+
+    auto data = file_.data();
+    auto size = file_.size();
+    LevelPackHeader header;
+    if (size < sizeof(header)) {
+        fprintf(stderr, "Level pack %s is truncated\n", path);
+        file_.close();
+        return false;
+    }
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, LEVEL_PACK_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != LEVEL_PACK_VERSION ||
+        sizeof(header) + header.count * sizeof(LevelPackEntry) > size) {
+        fprintf(stderr, "Level pack %s has an unsupported format\n", path);
+        file_.close();
+        return false;
+    }
+
+    auto entries = (const LevelPackEntry*) (data + sizeof(header));
+    for (uint32_t i = 0; i < header.count; i++) {
+        auto& entry = entries[i];
+        uint64_t tiles = (uint64_t) entry.width * entry.height;
+        bool in_bounds = entry.offset <= size && tiles <= size - entry.offset;
+        if (!in_bounds || memchr(entry.file, '\0', sizeof(entry.file)) == nullptr) {
+            fprintf(stderr, "Level pack %s has a corrupt entry\n", path);
+            index_.clear();
+            file_.close();
+            return false;
+        }
+        index_[entry.file] = &entry;
+    }
+    return true;
+}
+
+bool LevelPack::is_open() const {
+    return file_.is_open();
+}
+
+size_t LevelPack::size() const {
+    return index_.size();
+}
+
+const LevelPackEntry* LevelPack::find(const std::string& file) const {
+    auto it = index_.find(file);
+    return it == index_.end() ? nullptr : it->second;
+}
+
+const char* LevelPack::tiles(const LevelPackEntry& entry) const {
+    return (const char*) (file_.data() + entry.offset);
+}
@@ -0,0 +1,58 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#ifndef PANDAEXPRESS_LEVEL_PACK_H
+#define PANDAEXPRESS_LEVEL_PACK_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include "util/mapped_file.h"
+
+// Binary pack of every level's tiles, written offline by tools/level_compiler
+//
+// Layout: a LevelPackHeader, then header.count LevelPackEntry records, then the tiles
+// of each level as width * height bytes in row-major order. source_hash is hash_bytes
+// of the CSV the tiles came from, so an edited CSV is loaded instead of its stale entry.
+
+static const char LEVEL_PACK_MAGIC[4] = {'P', 'X', 'L', 'V'};
+static const uint32_t LEVEL_PACK_VERSION = 1;
+static const size_t LEVEL_PACK_NAME_LENGTH = 64;
+
+struct LevelPackHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t count;
+    uint32_t reserved;
+};
+
+struct LevelPackEntry {
+    char file[LEVEL_PACK_NAME_LENGTH]; // file name relative to data/levels, null terminated
+    uint64_t source_hash;
+    uint32_t width, height;
+    uint64_t offset; // from the start of the pack
+};
+
+// Read-only view of a memory-mapped level pack
+class LevelPack {
+private:
+    MappedFile file_;
+    std::unordered_map<std::string, const LevelPackEntry*> index_;
+
+public:
+    // maps the pack and validates its header and entries
+    bool open(const char* path);
+
+    bool is_open() const;
+
+    size_t size() const;
+
+    // returns nullptr if the file isn't in the pack
+    const LevelPackEntry* find(const std::string& file) const;
+
+    const char* tiles(const LevelPackEntry& entry) const;
+};
+
+#endif //PANDAEXPRESS_LEVEL_PACK_H
@@ -7,21 +7,118 @@
 #include <components/new_entrance.h>
 #include <components/food.h>
 #include <components/powerup.h>
+#include <components/static.h>
+#include <chrono>
+#include <cstdio>
 #include "level_system.h"
 
 LevelSystem::LevelSystem() : rng_(Random(4)),
-                             chunks_() {
+                             variant_rng_(Random(0)),
+                             requests_(),
+                             pool_(),
+                             preparer_(),
+                             chunks_(),
+                             live_chunks_(),
+                             next_chunk_id_(0),
+                             spawn_budget_left_(SPAWN_BUDGET_PER_FRAME),
+                             budget_exceeded_(false),
+                             budget_frames_(0),
+                             reported_budget_frames_(0),
+                             exceeded_frames_(0),
+                             forced_lines_(0) {
+}
+
+void LevelSystem::begin_chunk() {
+    live_chunks_.push_back({next_chunk_id_++, 0.f, false, {}});
+}
+
+uint32_t LevelSystem::spawn(entt::DefaultRegistry &registry, PrefabID prefab) {
+    if (live_chunks_.empty()) {
+        begin_chunk(); // levels that aren't streamed spawn everything into one chunk
+    }
+    auto &chunk = live_chunks_.back();
+    auto entity = pool_.acquire(registry, prefab);
+    registry.assign<ChunkMember>(entity, chunk.id);
+    chunk.entities.push_back(entity);
+    return entity;
+}
+
+void LevelSystem::reset_spawn_budget() {
+    spawn_budget_left_ = SPAWN_BUDGET_PER_FRAME;
+    budget_exceeded_ = false;
+    budget_frames_++;
+}
+
+bool LevelSystem::spend_spawn_budget(const ChunkCursor &cursor, bool inside_margin) {
+    size_t count = cursor.line_records();
+    // a line bigger than the whole budget still goes through when nothing was spawned yet this frame
+    bool nothing_spent = spawn_budget_left_ == SPAWN_BUDGET_PER_FRAME;
+    if (count <= spawn_budget_left_ || nothing_spent) {
+        spawn_budget_left_ -= count < spawn_budget_left_ ? count : spawn_budget_left_;
+        return true;
+    }
+    if (!inside_margin) {
+        return false; // wait for the next frame
+    }
+    // the camera caught up with generation, spawn anyway rather than let it see a gap
+    spawn_budget_left_ = 0;
+    forced_lines_++;
+    if (!budget_exceeded_) {
+        budget_exceeded_ = true;
+        exceeded_frames_++;
+    }
+    return true;
+}
+
+bool LevelSystem::is_member(entt::DefaultRegistry &registry, uint32_t entity, uint32_t chunk) const {
+    return registry.valid(entity) && registry.has<ChunkMember>(entity) &&
+           registry.get<ChunkMember>(entity).chunk == chunk;
+}
+
+EntityPool& LevelSystem::pool() {
+    return pool_;
+}
+
+void LevelSystem::cancel_chunks() {
+    preparer_.cancel();
+    for (auto &request : requests_) {
+        if (request.random) {
+            rng_ = request.picker;
+            break;
+        }
+    }
+    requests_.clear();
+}
+
+LevelSystem::ChunkRequest LevelSystem::chunk_request(int level) {
+    return {level, level < 0, (unsigned int) variant_rng_.nextInt(), rng_};
 }
 
 void LevelSystem::init(entt::DefaultRegistry &registry) {
+    cancel_chunks();
     destroy_entities(registry);
 }
 
-void LevelSystem::generateEntity(char value, float x, float y,
+PreparedChunk LevelSystem::prepare_chunk(int level, const SpawnList &spawns, Random &rng) {
+    PreparedChunk chunk;
+    chunk.level = level;
+    chunk.lines = (uint32_t) spawns.lines();
+    for (size_t line = 0; line < spawns.lines(); line++) {
+        for (auto spawn = spawns.begin(line); spawn != spawns.end(line); spawn++) {
+            // every record rolls so the sequence doesn't depend on which prefabs have variants
+            auto variant = (uint8_t) (rng.nextInt(0, 100) % 2);
+            chunk.records.push_back({(uint32_t) line, spawn->offset, spawn->tile, variant});
+        }
+    }
+    return chunk;
+}
+
+void LevelSystem::generateEntity(const SpawnRecord &record, float x, float y,
                                  Blackboard &blackboard, entt::DefaultRegistry &registry, SceneMode mode) {
-    switch (value) {
+    auto start = std::chrono::steady_clock::now();
+    switch (record.tile) {
         case '1': {
-            generate_platform(true, x, y, blackboard, registry);
+            generate_platform(true, record.variant, x, y, blackboard, registry);
         }
             break;
         case '3': {
@@ -45,7 +142,7 @@ void LevelSystem::generateEntity(char value, float x, float y,
         }
             break;
         case '8': {
-            generate_falling_platform(x, y, blackboard, registry);
+            generate_falling_platform(record.variant, x, y, blackboard, registry);
 
         }
             break;
@@ -59,7 +156,7 @@ void LevelSystem::generateEntity(char value, float x, float y,
         }
             break;
         case 'b': {
-            generate_platform(false, x, y, blackboard, registry);
+            generate_platform(false, record.variant, x, y, blackboard, registry);
         }
             break;
         case 'f': {
@@ -80,28 +177,29 @@ void LevelSystem::generateEntity(char value, float x, float y,
         }
             break;
         case 'w': {
-            generate_dirt(x, y, blackboard, registry);
+            generate_dirt(record.variant, x, y, blackboard, registry);
         }
             break;
         case 'z': {
-            generate_grass(x, y, blackboard, registry);
+            generate_grass(record.variant, x, y, blackboard, registry);
         }
             break;
         default:
             break;
     }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    pool_.record_spawn(elapsed.count());
 }
 
 void LevelSystem::generate_bread(bool move_left, float x, float y, Blackboard &blackboard,
                                  entt::DefaultRegistry &registry) {
-    auto texture = blackboard.texture_manager.get_texture("bread");
-    auto shader = blackboard.shader_manager.get_shader("sprite");
-    auto mesh = blackboard.mesh_manager.get_mesh("sprite");
+    auto &prefab = pool_.prefab(BREAD_PREFAB, blackboard);
+    auto &texture = prefab.textures[0];
     float scaleY = 75.0f / texture.height();
     float scaleX = 75.0f / texture.width();
-    auto bread = registry.create();
+    auto bread = spawn(registry, BREAD_PREFAB);
     registry.assign<Transform>(bread, x, y, 0., scaleX, scaleY);
-    registry.assign<Sprite>(bread, texture, shader, mesh);
+    registry.assign<Sprite>(bread, prefab.sprites[0]);
     registry.assign<Bread>(bread, move_left);
     registry.assign<CausesDamage>(bread, TOP_VULNERABLE_MASK, 1);
     registry.assign<Health>(bread, 1);
@@ -122,57 +220,64 @@ void LevelSystem::generate_bread(bool move_left, float x, float y, Blackboard &b
 */
 
 void LevelSystem::destroy_entities(entt::DefaultRegistry &registry) {
-    registry.destroy<Platform>();
-    registry.destroy<Llama>();
-    registry.destroy<Ghost>();
-    registry.destroy<Bread>();
-    registry.destroy<Obstacle>();
+    for (auto &chunk : live_chunks_) {
+        for (auto entity : chunk.entities) {
+            if (is_member(registry, entity, chunk.id)) {
+                pool_.despawn(registry, entity);
+            }
+        }
+    }
+    live_chunks_.clear();
+
+    pool_.despawn_all<Platform>(registry);
+    pool_.despawn_all<Llama>(registry);
+    pool_.despawn_all<Ghost>(registry);
+    pool_.despawn_all<Bread>(registry);
+    pool_.despawn_all<Obstacle>(registry);
     registry.destroy<Cave>();
     registry.destroy<NewEntrance>();
-    registry.destroy<Food>();
+    pool_.despawn_all<Food>(registry);
 
-    while (!chunks_.empty()) {
-        chunks_.front().clear();
-        chunks_.pop();
+    chunks_.clear();
+    pool_.print_stats();
+    preparer_.print_stats();
+    if (budget_frames_ != reported_budget_frames_) {
+        reported_budget_frames_ = budget_frames_;
+        printf("spawning: %zu of %zu frames over the %zu entity budget, %zu lines forced by the safety margin\n",
+               exceeded_frames_, budget_frames_, SPAWN_BUDGET_PER_FRAME, forced_lines_);
     }
 }
 
-void LevelSystem::generate_platform(bool one_way, float x, float y, Blackboard &blackboard,
+void LevelSystem::generate_platform(bool one_way, uint8_t variant, float x, float y, Blackboard &blackboard,
                                     entt::DefaultRegistry &registry) {
     float height = one_way ? PLATFORM_HEIGHT : (float) CELL_HEIGHT;
     y = one_way ? y - (float) CELL_HEIGHT / 2 + PLATFORM_HEIGHT / 2 : y;
-    auto texture = blackboard.texture_manager.get_texture(
-            (blackboard.randNumGenerator.nextInt(0, 100) % 2 == 0) ? "platform1"
-                                                                   : "platform2");;
-    if (!one_way) {
-        texture = blackboard.texture_manager.get_texture(
-                (blackboard.randNumGenerator.nextInt(0, 100) % 2 == 0) ? "solid_block_1" : "solid_block_2");
-    }
-    auto shader = blackboard.shader_manager.get_shader("sprite");
-    auto mesh = blackboard.mesh_manager.get_mesh("sprite");
+    PrefabID id = one_way ? ONE_WAY_PLATFORM_PREFAB : SOLID_PLATFORM_PREFAB;
+    auto &prefab = pool_.prefab(id, blackboard);
+    auto &texture = prefab.textures[variant];
     auto scaleX = static_cast<float>(CELL_WIDTH / texture.width());
     auto scaleY = static_cast<float>(height / texture.width());
-    auto platform = registry.create();
+    auto platform = spawn(registry, id);
     registry.assign<Platform>(platform, one_way);
     registry.assign<Transform>(platform, x, y, 0.,
                                scaleX,
                                scaleY);
-    registry.assign<Sprite>(platform, texture, shader, mesh);
+    registry.assign<Sprite>(platform, prefab.sprites[variant]);
     registry.assign<Collidable>(platform, texture.width() * scaleX,
                                 texture.height() * scaleY);
     registry.assign<Layer>(platform, TERRAIN_LAYER);
+    registry.assign<Static>(platform);
 }
 
 void LevelSystem::generate_ghost(float x, float y, Blackboard &blackboard, entt::DefaultRegistry &registry) {
-    auto texture = blackboard.texture_manager.get_texture("ghost");
-    auto shader = blackboard.shader_manager.get_shader("sprite");
-    auto mesh = blackboard.mesh_manager.get_mesh("sprite");
+    auto &prefab = pool_.prefab(GHOST_PREFAB, blackboard);
+    auto &texture = prefab.textures[0];
     float scaleY = 70.0f / texture.height();
     float scaleX = 85.0f / texture.width();
-    auto ghost = registry.create();
+    auto ghost = spawn(registry, GHOST_PREFAB);
     registry.assign<Transform>(ghost, x, y, 0., scaleX,
                                scaleY);
-    registry.assign<Sprite>(ghost, texture, shader, mesh);
+    registry.assign<Sprite>(ghost, prefab.sprites[0]);
     registry.assign<Ghost>(ghost);
     registry.assign<CausesDamage>(ghost, ALL_DMG_MASK, 1);
     registry.assign<Health>(ghost, 1);
@@ -183,15 +288,14 @@ void LevelSystem::generate_ghost(float x, float y, Blackboard &blackboard, entt:
 }
 
 void LevelSystem::generate_llama(float x, float y, Blackboard &blackboard, entt::DefaultRegistry &registry) {
-    auto texture = blackboard.texture_manager.get_texture("llama");
-    auto shader = blackboard.shader_manager.get_shader("sprite");
-    auto mesh = blackboard.mesh_manager.get_mesh("sprite");
+    auto &prefab = pool_.prefab(LLAMA_PREFAB, blackboard);
+    auto &texture = prefab.textures[0];
     float scaleY = 150.0f / texture.height();
     float scaleX = 150.0f / texture.width();
-    auto llama = registry.create();
+    auto llama = spawn(registry, LLAMA_PREFAB);
     registry.assign<Transform>(llama, x, y - 200, 0., scaleX,
                                scaleY);
-    registry.assign<Sprite>(llama, texture, shader, mesh);
+    registry.assign<Sprite>(llama, prefab.sprites[0]);
     registry.assign<Llama>(llama);
     registry.assign<CausesDamage>(llama, TOP_VULNERABLE_MASK, 1);
     registry.assign<Health>(llama, 1);
@@ -207,9 +311,8 @@ void LevelSystem::generate_llama(float x, float y, Blackboard &blackboard, entt:
 
 void LevelSystem::generate_spike(bool tall, bool floating, float x, float y, Blackboard &blackboard,
         entt::DefaultRegistry &registry) {
-    auto texture = blackboard.texture_manager.get_texture("stalagmite");
-    auto shader = blackboard.shader_manager.get_shader("sprite");
-    auto mesh = blackboard.mesh_manager.get_mesh("sprite");
+    auto &prefab = pool_.prefab(SPIKE_PREFAB, blackboard);
+    auto &texture = prefab.textures[0];
 
     auto scaleX = static_cast<float>(CELL_WIDTH / texture.width());
     auto scaleY = scaleX * 1.8;
@@ -222,32 +325,30 @@ void LevelSystem::generate_spike(bool tall, bool floating, float x, float y, Bla
             y = y - (float) CELL_HEIGHT * 0.40 + PLATFORM_HEIGHT;
         }
     }
-    auto stalagmite = registry.create();
+    auto stalagmite = spawn(registry, SPIKE_PREFAB);
     registry.assign<Obstacle>(stalagmite);
     registry.assign<CausesDamage>(stalagmite, BOTTOM_VULNERABLE_MASK, 1);
     registry.assign<Platform>(stalagmite, false);
     registry.assign<Transform>(stalagmite, x, y, 0., scaleX, scaleY);
-    registry.assign<Sprite>(stalagmite, texture, shader, mesh);
+    registry.assign<Sprite>(stalagmite, prefab.sprites[0]);
     registry.assign<Collidable>(stalagmite, texture.width() * scaleX,
                                 texture.height() * scaleY);
     registry.assign<Layer>(stalagmite, TERRAIN_LAYER);
+    registry.assign<Static>(stalagmite);
 }
 
-void LevelSystem::generate_falling_platform(float x, float y, Blackboard &blackboard, entt::DefaultRegistry &registry) {
-    auto texture = blackboard.texture_manager.get_texture(
-            (blackboard.randNumGenerator.nextInt(0, 100) % 2 == 0) ? "falling_blocks_1"
-                                                                   : "falling_blocks_2");
-    auto shader = blackboard.shader_manager.get_shader("sprite");
-    auto mesh = blackboard.mesh_manager.get_mesh("sprite");
+void LevelSystem::generate_falling_platform(uint8_t variant, float x, float y, Blackboard &blackboard, entt::DefaultRegistry &registry) {
+    auto &prefab = pool_.prefab(FALLING_PLATFORM_PREFAB, blackboard);
+    auto &texture = prefab.textures[variant];
     auto scaleX = static_cast<float>(CELL_WIDTH / texture.width());
     auto scaleY = static_cast<float>(PLATFORM_HEIGHT / texture.width());
-    auto falling_platform = registry.create();
+    auto falling_platform = spawn(registry, FALLING_PLATFORM_PREFAB);
 
     registry.assign<Platform>(falling_platform, false, true);
     registry.assign<Transform>(falling_platform, x,
                                y - CELL_HEIGHT / 2 + PLATFORM_HEIGHT / 2, 0., scaleX,
                                scaleY);
-    registry.assign<Sprite>(falling_platform, texture, shader, mesh);
+    registry.assign<Sprite>(falling_platform, prefab.sprites[variant]);
     registry.assign<Collidable>(falling_platform, texture.width() * scaleX,
                                 texture.height() * scaleY);
 
@@ -288,14 +389,13 @@ void LevelSystem::generate_cave(float x, float y, Blackboard &blackboard, entt::
 }
 
 void LevelSystem::generate_food(float x, float y, Blackboard &blackboard, entt::DefaultRegistry &registry) {
-    auto burger = registry.create();
-    auto texture = blackboard.texture_manager.get_texture("burger");
-    auto shader = blackboard.shader_manager.get_shader("sprite");
-    auto mesh = blackboard.mesh_manager.get_mesh("sprite");
+    auto burger = spawn(registry, FOOD_PREFAB);
+    auto &prefab = pool_.prefab(FOOD_PREFAB, blackboard);
+    auto &texture = prefab.textures[0];
     auto scaleX = static_cast<float>(CELL_WIDTH * 0.5f / texture.width());
     auto scaleY = static_cast<float>(CELL_HEIGHT * 0.5f / texture.height());
     registry.assign<Food>(burger);
-    registry.assign<Sprite>(burger, texture, shader, mesh);
+    registry.assign<Sprite>(burger, prefab.sprites[0]);
     registry.assign<Transform>(burger, x, y, 0., scaleX, scaleY);
     registry.assign<Interactable>(burger);
     registry.assign<ObeysGravity>(burger);
@@ -306,16 +406,15 @@ void LevelSystem::generate_food(float x, float y, Blackboard &blackboard, entt::
 }
 
 void LevelSystem::generate_shield(float x, float y, Blackboard &blackboard, entt::DefaultRegistry &registry) {
-    auto shield = registry.create();
-    auto texture = blackboard.texture_manager.get_texture("shield");
-    auto shader = blackboard.shader_manager.get_shader("sprite");
-    auto mesh = blackboard.mesh_manager.get_mesh("sprite");
+    auto shield = spawn(registry, SHIELD_PREFAB);
+    auto &prefab = pool_.prefab(SHIELD_PREFAB, blackboard);
+    auto &texture = prefab.textures[0];
 
     const float scale = 0.8f;
     const float y_offset = 10.f;
 
     registry.assign<Powerup>(shield, SHIELD_POWERUP);
-    registry.assign<Sprite>(shield, texture, shader, mesh);
+    registry.assign<Sprite>(shield, prefab.sprites[0]);
     registry.assign<Transform>(shield, x, y + y_offset, 0, scale, scale);
     registry.assign<Interactable>(shield);
     registry.assign<Collidable>(shield, texture.width() * scale, texture.height() * scale);
@@ -324,14 +423,13 @@ void LevelSystem::generate_shield(float x, float y, Blackboard &blackboard, entt
 
 void LevelSystem::generate_vial(float x, float y, Blackboard &blackboard,
                                 entt::DefaultRegistry &registry) {
-    auto vial = registry.create();
-    auto texture = blackboard.texture_manager.get_texture("vial");
-    auto shader = blackboard.shader_manager.get_shader("sprite");
-    auto mesh = blackboard.mesh_manager.get_mesh("sprite");
+    auto vial = spawn(registry, VIAL_PREFAB);
+    auto &prefab = pool_.prefab(VIAL_PREFAB, blackboard);
+    auto &texture = prefab.textures[0];
     auto scaleX = static_cast<float>((CELL_HEIGHT / 3.0f)  / texture.width());
     auto scaleY = static_cast<float>(CELL_HEIGHT / texture.height());
     registry.assign<Powerup>(vial, VAPE_POWERUP);
-    registry.assign<Sprite>(vial, texture, shader, mesh);
+    registry.assign<Sprite>(vial, prefab.sprites[0]);
     registry.assign<Transform>(vial, x, y, 0.785f, scaleX, scaleY); // rotate by PI/4
     registry.assign<Interactable>(vial);
     registry.assign<Collidable>(vial, texture.width() * scaleX,
@@ -339,41 +437,37 @@ void LevelSystem::generate_vial(float x, float y, Blackboard &blackboard,
     registry.assign<Layer>(vial, ITEM_LAYER);
 }
 
-void LevelSystem::generate_dirt(float x, float y, Blackboard &blackboard,
+void LevelSystem::generate_dirt(uint8_t variant, float x, float y, Blackboard &blackboard,
                                 entt::DefaultRegistry &registry) {
-    auto dirt = registry.create();
-    auto texture = blackboard.texture_manager.get_texture(
-            (blackboard.randNumGenerator.nextInt(0, 100) % 2 == 0) ? "dirt_1"
-                                                                   : "dirt_2");
-    auto shader = blackboard.shader_manager.get_shader("sprite");
-    auto mesh = blackboard.mesh_manager.get_mesh("sprite");
+    auto dirt = spawn(registry, DIRT_PREFAB);
+    auto &prefab = pool_.prefab(DIRT_PREFAB, blackboard);
+    auto &texture = prefab.textures[variant];
     auto scaleX = static_cast<float>((CELL_WIDTH / texture.width()));
     auto scaleY = static_cast<float>(CELL_HEIGHT*1.8 / texture.height());
-    registry.assign<Sprite>(dirt, texture, shader, mesh);
+    registry.assign<Sprite>(dirt, prefab.sprites[variant]);
     registry.assign<Transform>(dirt, x, y, 0.f, scaleX, scaleY);
     registry.assign<Interactable>(dirt);
     registry.assign<Platform>(dirt, true);
     registry.assign<Collidable>(dirt, texture.width() * scaleX,
                                 texture.height() * scaleY);
     registry.assign<Layer>(dirt, TERRAIN_LAYER - 1);
+    registry.assign<Static>(dirt);
 }
 
-void LevelSystem::generate_grass(float x, float y, Blackboard &blackboard,
+void LevelSystem::generate_grass(uint8_t variant, float x, float y, Blackboard &blackboard,
                                 entt::DefaultRegistry &registry) {
-    auto grass = registry.create();
-    auto texture = blackboard.texture_manager.get_texture(
-            (blackboard.randNumGenerator.nextInt(0, 100) % 2 == 0) ? "grass_1"
-                                                                   : "grass_2");
-    auto shader = blackboard.shader_manager.get_shader("sprite");
-    auto mesh = blackboard.mesh_manager.get_mesh("sprite");
+    auto grass = spawn(registry, GRASS_PREFAB);
+    auto &prefab = pool_.prefab(GRASS_PREFAB, blackboard);
+    auto &texture = prefab.textures[variant];
     auto scaleX = static_cast<float>(CELL_WIDTH / texture.width());
     auto scaleY = static_cast<float>(CELL_HEIGHT / texture.width());
     registry.assign<Platform>(grass, false);
     registry.assign<Transform>(grass, x, y, 0.,
                                scaleX,
                                scaleY);
-    registry.assign<Sprite>(grass, texture, shader, mesh);
+    registry.assign<Sprite>(grass, prefab.sprites[variant]);
     registry.assign<Collidable>(grass, texture.width() * scaleX,
                                 texture.height() * scaleY);
     registry.assign<Layer>(grass, TERRAIN_LAYER);
+    registry.assign<Static>(grass);
 }
\ No newline at end of file
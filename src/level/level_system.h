@@ -21,38 +21,133 @@
 #include <components/obstacle.h>
 #include <components/interactable.h>
 #include <components/obeys_gravity.h>
+#include <components/timer.h>
 #include <graphics/cave.h>
 #include <graphics/cave_entrance.h>
 #include "util/random.h"
 #include "systems/system.h"
 #include <scene/scene_mode.h>
-#include <queue>
+#include <deque>
+#include "spawn_list.h"
+#include "chunk_preparer.h"
+#include "entity_pool.h"
 #include <util/constants.h>
+#include <components/chunk_member.h>
 
 class LevelSystem : public System {
 private:
-    void generate_platform(bool one_way, float x, float y, Blackboard &blackboard, entt::DefaultRegistry &registry);
+    void generate_platform(bool one_way, uint8_t variant, float x, float y, Blackboard &blackboard, entt::DefaultRegistry &registry);
     void generate_bread(bool move_left, float x, float y, Blackboard &blackboard, entt::DefaultRegistry &registry);
     void generate_ghost(float x, float y, Blackboard &blackboard, entt::DefaultRegistry &registry);
     void generate_llama(float x, float y, Blackboard &blackboard, entt::DefaultRegistry &registry);
     void generate_spike(bool tall, bool floating, float x, float y, Blackboard &blackboard, entt::DefaultRegistry &registry);
-    void generate_falling_platform(float x, float y, Blackboard &blackboard, entt::DefaultRegistry &registry);
+    void generate_falling_platform(uint8_t variant, float x, float y, Blackboard &blackboard, entt::DefaultRegistry &registry);
     void generate_cave(float x, float y, Blackboard &blackboard, entt::DefaultRegistry &registry);
     void generate_food(float x, float y, Blackboard &blackboard, entt::DefaultRegistry &registry);
     void generate_shield(float x, float y, Blackboard &blackboard, entt::DefaultRegistry &registry);
     void generate_vial(float x, float y, Blackboard &blackboard, entt::DefaultRegistry &registry);
-    void generate_dirt(float x, float y, Blackboard &blackboard, entt::DefaultRegistry &registry);
-    void generate_grass(float x, float y, Blackboard &blackboard, entt::DefaultRegistry &registry);
+    void generate_dirt(uint8_t variant, float x, float y, Blackboard &blackboard, entt::DefaultRegistry &registry);
+    void generate_grass(uint8_t variant, float x, float y, Blackboard &blackboard, entt::DefaultRegistry &registry);
 
 protected:
-    Random rng_;
-    std::queue<std::vector<char>> chunks_;
+    // entities spawned while generating one queued chunk, despawned together when it's retired
+    struct StreamedChunk {
+        uint32_t id;
+        float last_line; // position of the last line generated so far
+        bool complete;
+        std::vector<uint32_t> entities;
+    };
+
+    // a chunk handed to the preparer and not taken yet. A random one is picked from the difficulty
+    // range when it's queued, picker is rng_ as it was right before, so a requeue or cancel can rewind
+    // rng_ and pick again in the same order. seed feeds the job's rng for texture variants.
+    struct ChunkRequest {
+        int level;
+        bool random;
+        unsigned int seed;
+        Random picker;
+    };
+
+    Random rng_; // main thread only, picks the random chunks in the order they're loaded
+    Random variant_rng_; // main thread only, draws the seed of each requested chunk
+    std::deque<ChunkRequest> requests_; // in the order the preparer will hand them back
+    EntityPool pool_;
+    ChunkPreparer preparer_;
+    std::deque<ChunkCursor> chunks_;
+    std::deque<StreamedChunk> live_chunks_;
+    uint32_t next_chunk_id_;
+
+    size_t spawn_budget_left_;
+    bool budget_exceeded_; // this frame
+    size_t budget_frames_; // frames the budget was refilled in
+    size_t reported_budget_frames_;
+    size_t exceeded_frames_;
+    size_t forced_lines_;
 
     const float PLATFORM_HEIGHT = 20.f;
+    // chunks kept prepared ahead of the one being loaded
+    static const size_t PREPARE_AHEAD = 2;
+    // entities instantiated per frame while generating ahead of the camera
+    static const size_t SPAWN_BUDGET_PER_FRAME = 24;
+    // lines past the visible edge that are generated even when the frame's budget is spent
+    static const int SPAWN_SAFETY_LINES = 2;
+
+    // Resolves a level into spawn records, rolling texture variants with the job's rng.
+    // Runs on the preparer's worker for streamed levels, so it must not touch the blackboard or registry.
+    PreparedChunk prepare_chunk(int level, const SpawnList &spawns, Random &rng);
 
-    void generateEntity(char value, float x, float y,
+    // drops every chunk requested and not taken yet, rng_ goes back to before the first random pick
+    void cancel_chunks();
+
+    // the request for a chunk, random ones pick their level in queue_chunk()
+    ChunkRequest chunk_request(int level);
+
+    void generateEntity(const SpawnRecord &record, float x, float y,
                         Blackboard &blackboard, entt::DefaultRegistry &registry, SceneMode mode);
 
+    // entities spawned from here on belong to a new chunk
+    void begin_chunk();
+
+    // refills the spawn budget, called once per frame before generating
+    void reset_spawn_budget();
+
+    // Whether the cursor's next line may be generated this frame, spending the budget if so.
+    // Lines inside the safety margin are always generated and count the frame as over budget
+    // when they don't fit, the first line of a frame always fits so big lines still progress.
+    bool spend_spawn_budget(const ChunkCursor &cursor, bool inside_margin);
+
+    // acquires an entity from the pool and tags it with the chunk being generated
+    uint32_t spawn(entt::DefaultRegistry &registry, PrefabID prefab);
+
+    // Retires the oldest chunks while they're complete, the camera has passed their last line,
+    // and a newer chunk exists. axis is the Transform coordinate the level streams along;
+    // members that moved and aren't behind the camera yet are handed to the next chunk.
+    template<typename Behind>
+    void retire_chunks(entt::DefaultRegistry &registry, float Transform::*axis, Behind behind) {
+        while (live_chunks_.size() > 1 && live_chunks_.front().complete &&
+               behind(live_chunks_.front().last_line)) {
+            auto &retired = live_chunks_.front();
+            auto &next = live_chunks_[1];
+            for (auto entity : retired.entities) {
+                if (!is_member(registry, entity, retired.id)) {
+                    continue; // already despawned, possibly reused by a newer chunk
+                }
+                if (registry.has<Transform>(entity)) {
+                    auto &transform = registry.get<Transform>(entity);
+                    if (!behind(transform.*axis)) {
+                        registry.get<ChunkMember>(entity).chunk = next.id;
+                        next.entities.push_back(entity);
+                        continue;
+                    }
+                }
+                pool_.despawn(registry, entity);
+            }
+            live_chunks_.pop_front();
+        }
+    }
+
+    bool is_member(entt::DefaultRegistry &registry, uint32_t entity, uint32_t chunk) const;
+
 
 public:
 
@@ -63,8 +158,12 @@ public:
     void update(Blackboard &blackboard, entt::DefaultRegistry &registry) override = 0;
 
     virtual void destroy_entities(entt::DefaultRegistry &registry);
-    const std::string FALLING_PLATFORM_TIMER_LABEL = "fall";
-    const std::string SPIT_TIMER_LABEL = "spit";
+
+    // shared with systems that spawn or despawn level entities
+    EntityPool& pool();
+
+    const TimerLabel FALLING_PLATFORM_TIMER_LABEL = Timer::label("fall");
+    const TimerLabel SPIT_TIMER_LABEL = Timer::label("spit");
     static const unsigned int STORY_SEED = 7;
 
 };
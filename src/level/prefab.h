@@ -0,0 +1,38 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#ifndef PANDAEXPRESS_PREFAB_H
+#define PANDAEXPRESS_PREFAB_H
+
+#include <vector>
+
+#include "graphics/sprite.h"
+#include "graphics/texture.h"
+
+enum PrefabID {
+    ONE_WAY_PLATFORM_PREFAB,
+    SOLID_PLATFORM_PREFAB,
+    BREAD_PREFAB,
+    GHOST_PREFAB,
+    LLAMA_PREFAB,
+    SPIKE_PREFAB,
+    FALLING_PLATFORM_PREFAB,
+    FOOD_PREFAB,
+    SHIELD_PREFAB,
+    VIAL_PREFAB,
+    DIRT_PREFAB,
+    GRASS_PREFAB,
+    SPIT_PREFAB,
+    PREFAB_COUNT
+};
+
+// Resources of an archetype resolved once, with one sprite per texture variant
+struct Prefab {
+    std::vector<Texture> textures;
+    std::vector<Sprite> sprites;
+
+    bool resolved() const { return !sprites.empty(); }
+};
+
+#endif //PANDAEXPRESS_PREFAB_H
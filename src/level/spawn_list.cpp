@@ -0,0 +1,55 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#include "spawn_list.h"
+
+static bool is_empty_tile(char tile) {
+    return tile == '0' || tile == '\0';
+}
+
+SpawnList::SpawnList() : spawns_(), line_starts_(1, 0) {}
+
+void SpawnList::add_line() {
+    line_starts_.push_back((uint32_t) spawns_.size());
+}
+
+SpawnList SpawnList::columns(const Level& level) {
+    SpawnList list;
+    for (size_t x = 0; x < level.width(); x++) {
+        for (size_t y = 0; y < level.height(); y++) {
+            char tile = level.get_tile_at((int) x, (int) y);
+            if (!is_empty_tile(tile)) {
+                list.spawns_.push_back({(uint32_t) y, tile});
+            }
+        }
+        list.add_line();
+    }
+    return list;
+}
+
+SpawnList SpawnList::rows_bottom_up(const Level& level) {
+    SpawnList list;
+    for (int y = (int) level.height() - 1; y >= 0; y--) {
+        for (size_t x = 0; x < level.width(); x++) {
+            char tile = level.get_tile_at((int) x, y);
+            if (!is_empty_tile(tile)) {
+                list.spawns_.push_back({(uint32_t) x, tile});
+            }
+        }
+        list.add_line();
+    }
+    return list;
+}
+
+size_t SpawnList::lines() const {
+    return line_starts_.size() - 1;
+}
+
+const Spawn* SpawnList::begin(size_t line) const {
+    return spawns_.data() + line_starts_[line];
+}
+
+const Spawn* SpawnList::end(size_t line) const {
+    return spawns_.data() + line_starts_[line + 1];
+}
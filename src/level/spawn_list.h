@@ -0,0 +1,45 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#ifndef PANDAEXPRESS_SPAWN_LIST_H
+#define PANDAEXPRESS_SPAWN_LIST_H
+
+#include <cstdint>
+#include <vector>
+
+#include "level.h"
+
+// A non-empty tile, offset is its cell index along the line it belongs to
+struct Spawn {
+    uint32_t offset;
+    char tile;
+};
+
+// The non-empty tiles of a level, split into the lines (columns or rows) it is streamed in
+// and sorted by offset within each line. Built once when a level is loaded, so streaming
+// only visits tiles that spawn something.
+class SpawnList {
+private:
+    std::vector<Spawn> spawns_;
+    std::vector<uint32_t> line_starts_; // lines() + 1 indices into spawns_
+
+    void add_line();
+
+public:
+    // one line per column left to right, offsets count down from the top row
+    static SpawnList columns(const Level& level);
+
+    // one line per row bottom to top, offsets count right from the first column
+    static SpawnList rows_bottom_up(const Level& level);
+
+    SpawnList();
+
+    size_t lines() const;
+
+    const Spawn* begin(size_t line) const;
+
+    const Spawn* end(size_t line) const;
+};
+
+#endif //PANDAEXPRESS_SPAWN_LIST_H
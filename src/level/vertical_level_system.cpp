@@ -9,18 +9,23 @@
 
 VerticalLevelSystem::VerticalLevelSystem() :
         LevelSystem(),
-        mode_(ENDLESS),
         min_difficulty(MIN_DIFFICULTY_EASY),
         max_difficulty(MAX_DIFFICULTY_HARD),
-        difficulty_range(DIFFICULTY_RANGE_ENDLESS) {
+        difficulty_range(DIFFICULTY_RANGE_ENDLESS),
+        mode_(ENDLESS),
+        prepared_(false) {
     for (int i = 0; i <= MAX_DIFFICULTY_HARD; i++) {
-        levels[i] = Level::load_level(i, VERTICAL_LEVEL_TYPE);
+        levels[i] = SpawnList::rows_bottom_up(Level::load_level(i, VERTICAL_LEVEL_TYPE));
     }
-    levels[END_LEVEL] = Level::load_level(END_LEVEL, VERTICAL_LEVEL_TYPE);
+    levels[END_LEVEL] = SpawnList::rows_bottom_up(Level::load_level(END_LEVEL, VERTICAL_LEVEL_TYPE));
 }
 
-void VerticalLevelSystem::init(SceneMode mode, entt::DefaultRegistry &registry) {
-    LevelSystem::init(registry);
+VerticalLevelSystem::~VerticalLevelSystem() {
+    preparer_.cancel();
+}
+
+void VerticalLevelSystem::prepare(SceneMode mode) {
+    cancel_chunks();
 
     mode_ = mode;
     if (mode_ == ENDLESS) {
@@ -39,60 +44,122 @@ void VerticalLevelSystem::init(SceneMode mode, entt::DefaultRegistry &registry)
         max_difficulty = MAX_DIFFICULTY_HARD;
         difficulty_range = DIFFICULTY_RANGE_STORY;
     }
+    variant_rng_.init(0);
 
-    last_row_generated_ = last_row_loaded_ = FIRST_ROW_Y;
     difficulty = min_difficulty;
-    difficulty_timer.save_watch(LEVEL_UP_LABEL, LEVEL_UP_INTERVAL);
     if (mode_ == ENDLESS) {
-        load_next_chunk(2);
+        request_chunk(2);
     } else if (mode_ == STORY_EASY) {
-        load_next_chunk(0);
+        request_chunk(0);
     } else if (mode_ == STORY_HARD) {
-        load_next_chunk(16);
+        request_chunk(16);
+    }
+    // the chunks init() would have topped up with right after taking the first one
+    for (size_t i = 0; i < PREPARE_AHEAD; i++) {
+        request_chunk();
     }
+    prepared_ = true;
 }
 
-void VerticalLevelSystem::load_next_chunk() {
-    int level;
+void VerticalLevelSystem::init(SceneMode mode, entt::DefaultRegistry &registry) {
+    if (!prepared_ || mode_ != mode) {
+        prepare(mode);
+    }
+    prepared_ = false;
+    destroy_entities(registry);
+
+    last_row_generated_ = last_row_loaded_ = FIRST_ROW_Y;
+    difficulty = min_difficulty;
+    difficulty_timer.save_watch(LEVEL_UP_LABEL, LEVEL_UP_INTERVAL);
+    load_next_chunk();
+}
+
+void VerticalLevelSystem::request_chunk() {
+    queue_chunk(chunk_request(-1));
+}
+
+void VerticalLevelSystem::request_chunk(int id) {
+    queue_chunk(chunk_request(id));
+}
+
+void VerticalLevelSystem::queue_chunk(ChunkRequest request) {
+    // difficulty is read now, requeue_chunks() prepares the chunk again when it goes up
+    int low;
     if (mode_ == ENDLESS) {
-        level = rng_.nextInt(std::max(1, difficulty - difficulty_range), difficulty);
+        low = std::max(1, difficulty - difficulty_range);
     } else{
-        level = rng_.nextInt(std::max(0, difficulty - difficulty_range), difficulty);
+        low = std::max(0, difficulty - difficulty_range);
+    }
+    int high = difficulty;
+    if (request.random) {
+        // picked here rather than on the worker, in the order the chunks are loaded
+        request.picker = rng_;
+        request.level = rng_.nextInt(low, high);
     }
+    requests_.push_back(request);
+    int level = request.level;
+    unsigned int seed = request.seed;
+    preparer_.request([this, level, seed]() {
+        Random rng(seed);
+        return prepare_chunk(level, levels.at(level), rng);
+    });
+}
 
-    load_next_chunk(level);
+void VerticalLevelSystem::requeue_chunks() {
+    std::deque<ChunkRequest> queued = requests_;
+    cancel_chunks(); // rewinds rng_, the random chunks are picked again from the new range
+    for (auto &request : queued) {
+        queue_chunk(request);
+    }
 }
 
-void VerticalLevelSystem::load_next_chunk(int id) {
-    Level lvl = levels[id];
-    for (int y = (int) lvl.height() - 1; y >= 0; y--) {
-        std::vector<char> row;
-        row.reserve(lvl.width());
-        for (int x = 0; x < lvl.width(); x++) {
-            row.push_back(lvl.get_tile_at(x, y));
-        }
-        last_row_loaded_ -= CELL_HEIGHT;
-        chunks_.push(row);
+void VerticalLevelSystem::load_next_chunk() {
+    PreparedChunk chunk = preparer_.take();
+    requests_.pop_front();
+    last_row_loaded_ -= CELL_HEIGHT * chunk.lines;
+    if (chunk.lines > 0) {
+        chunks_.push_back({std::move(chunk), 0, 0});
+    }
+    while (preparer_.pending() < PREPARE_AHEAD) {
+        request_chunk();
     }
 }
 
 void VerticalLevelSystem::generate_next_chunk(Blackboard &blackboard,
                                               entt::DefaultRegistry &registry) {
+    // rows well above the top edge are generated ahead of time within the frame's budget,
+    // the ones inside the safety margin are generated whatever it costs
     float off_screen = blackboard.camera.position().y - blackboard.camera.size().x;
+    float margin = blackboard.camera.position().y - blackboard.camera.size().y / 2 -
+                   (float) CELL_HEIGHT * SPAWN_SAFETY_LINES;
+    reset_spawn_budget();
     while (last_row_generated_ > off_screen && !chunks_.empty()) {
-        std::vector<char> col = chunks_.front();
-        float x = COL_X_OFFSET;
-        for (int c:col) {
-            generateEntity(c, x, last_row_generated_, blackboard, registry, mode_);
-            x += CELL_WIDTH;
+        ChunkCursor &cursor = chunks_.front();
+        if (!spend_spawn_budget(cursor, last_row_generated_ > margin)) {
+            break;
+        }
+        if (cursor.line == 0) {
+            begin_chunk();
+        }
+        auto &records = cursor.chunk.records;
+        for (; cursor.next_record < records.size() && records[cursor.next_record].line == cursor.line;
+               cursor.next_record++) {
+            auto &record = records[cursor.next_record];
+            float x = COL_X_OFFSET + (float) CELL_WIDTH * record.offset;
+            generateEntity(record, x, last_row_generated_, blackboard, registry, mode_);
         }
+        live_chunks_.back().last_line = last_row_generated_;
         last_row_generated_ -= CELL_HEIGHT;
-        chunks_.pop();
+        cursor.line++;
+        if (cursor.done()) {
+            live_chunks_.back().complete = true;
+            chunks_.pop_front();
+        }
     }
 }
 
 void VerticalLevelSystem::destroy_entities(entt::DefaultRegistry &registry) {
-    registry.destroy<Spit>(); // Destroy Spit here since it was not generated by LevelSystem
+    pool_.despawn_all<Spit>(registry); // Destroy Spit here since it was not generated by LevelSystem
     LevelSystem::destroy_entities(registry);
 }
 
@@ -110,6 +177,7 @@ void VerticalLevelSystem::update(Blackboard &blackboard, entt::DefaultRegistry &
     if (difficulty < max_difficulty && difficulty_timer.is_done(LEVEL_UP_LABEL)) {
         difficulty++;
         difficulty_timer.reset_watch(LEVEL_UP_LABEL);
+        requeue_chunks();
     }
 
     destroy_off_screen(registry, max_y);
@@ -117,32 +185,14 @@ void VerticalLevelSystem::update(Blackboard &blackboard, entt::DefaultRegistry &
 }
 
 void VerticalLevelSystem::destroy_off_screen(entt::DefaultRegistry &registry, float max_y) {
-    auto platforms = registry.view<Platform, Transform>();
-    for (uint32_t entity: platforms) {
-        auto &transform = platforms.get<Transform>(entity);
-        if (transform.y > max_y) {
-            registry.destroy(entity);
-        }
-    }
-
-    auto llamas = registry.view<Llama, Transform>();
-    for (uint32_t entity: llamas) {
-        auto &transform = llamas.get<Transform>(entity);
-        if (transform.y > max_y) {
-            registry.destroy(entity);
-        }
-    }
-
-    auto spits = registry.view<Spit, Transform>();
-    for (uint32_t entity: spits) {
-        auto &transform = spits.get<Transform>(entity);
-        if (transform.y > max_y) {
-            registry.destroy(entity);
-        }
-    }
+    // enemies and spit that leave the screen earlier are despawned by the EnemySystem
+    retire_chunks(registry, &Transform::y, [max_y](float row) { return row > max_y; });
 }
 
 void VerticalLevelSystem::generate_end_level() {
-    load_next_chunk(END_LEVEL);
+    // drop the random chunks prepared ahead so the end level comes next
+    cancel_chunks();
+    request_chunk(END_LEVEL);
+    load_next_chunk();
 }
 
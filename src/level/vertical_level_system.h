@@ -12,11 +12,20 @@
 #include <scene/scene_mode.h>
 #include "level_system.h"
 #include "level.h"
+#include "spawn_list.h"
 
 class VerticalLevelSystem : public LevelSystem {
 private:
+    // takes the next prepared chunk and keeps PREPARE_AHEAD more in preparation
     void load_next_chunk();
-    void load_next_chunk(int level);
+
+    // prepares a random level of the current difficulty
+    void request_chunk();
+    void request_chunk(int id);
+    void queue_chunk(ChunkRequest request);
+
+    // the queued chunks were rolled for the old difficulty, prepares them again with their seeds
+    void requeue_chunks();
 
     void generate_next_chunk(Blackboard &blackboard, entt::DefaultRegistry &registry);
 
@@ -31,7 +40,7 @@ private:
     const int DIFFICULTY_RANGE_STORY = 2;
     const int DIFFICULTY_RANGE_ENDLESS = 7;
     const float LEVEL_UP_INTERVAL = 5;
-    const std::string LEVEL_UP_LABEL = "level_up";
+    const TimerLabel LEVEL_UP_LABEL = Timer::label("level_up");
 
     const int END_LEVEL = 50;
 
@@ -45,13 +54,21 @@ private:
     Timer difficulty_timer;
 
     SceneMode mode_;
+    bool prepared_;
 
-    std::unordered_map<int, Level> levels;
+    std::unordered_map<int, SpawnList> levels;
 
 public:
 
     VerticalLevelSystem();
 
+    // prepare jobs read levels, so they have to finish before it's destroyed
+    ~VerticalLevelSystem();
+
+    // seeds the level and queues its first chunks without touching the registry, so it can run
+    // while another scene is still playing; init() with the same mode then starts without waiting
+    void prepare(SceneMode mode);
+
     void init(SceneMode mode, entt::DefaultRegistry &registry);
 
     void update(Blackboard &blackboard, entt::DefaultRegistry &registry) override;
@@ -21,6 +21,7 @@
 #include <sstream>
 #include <scene/vertical_scene.h>
 #include <util/csv_reader.h>
+#include <level/level.h>
 #include <iostream>
 #include <scene/boss_scene.h>
 #include <graphics/health_bar.h>
@@ -30,11 +31,57 @@
 #include <scene/story_intro_beach.h>
 #include <scene/story_intro_jungle.h>
 #include <scene/story_end_scene.h>
+#include <util/frame_stats.h>
+#include <util/frame_arena.h>
+#include <util/input_recording.h>
+#include <util/hash.h>
+#include <util/job_system.h>
+#include <cstring>
 
 
 
-int start() {
+int start(int argc, char** argv) {
+    uint64_t start_time = SDL_GetPerformanceCounter();
+    auto startup_ms = [start_time]() {
+        return (SDL_GetPerformanceCounter() - start_time) * 1000.f / SDL_GetPerformanceFrequency();
+    };
+
+    // --record <file> saves the run's input, --replay <file> plays one back,
+    // --headless skips rendering while replaying so the run is simulation only,
+    // --teardown-scenes destroys each scene when it's left instead of keeping it until exit
+    const char* record_path = nullptr;
+    const char* replay_path = nullptr;
+    bool headless = false;
+    bool teardown_scenes = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            record_path = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replay_path = argv[++i];
+        } else if (strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else if (strcmp(argv[i], "--teardown-scenes") == 0) {
+            teardown_scenes = true;
+        } else {
+            fprintf(stderr, "unknown argument %s\n", argv[i]);
+        }
+    }
+
+    InputReplay replay;
+    if (replay_path != nullptr && !replay.open(replay_path)) {
+        return EXIT_FAILURE;
+    }
+    if (headless && !replay.is_open()) {
+        fprintf(stderr, "--headless only applies to --replay, rendering anyway\n");
+        headless = false;
+    }
+    // every random draw in the simulation comes from srand or the blackboard rng,
+    // an unseeded rand() behaves as if seeded with 1, so that's the seed without a replay
+    unsigned int seed = replay.is_open() ? replay.seed() : 1;
+    srand(seed);
+
     Window window("Express Panda");
+    JobSystem::instance(); // the main thread owns the job system's first deque, create it from here
 
     Blackboard blackboard = {
         Camera(1600, 900, 0, 0),
@@ -44,10 +91,10 @@ int start() {
         ShaderManager(),
         TextureManager(),
         window,
-        Random(0),
+        Random(seed),
         SoundManager(),
         FontManager(),
-        std::unique_ptr<Shader>(),
+        PostProcessChain(),
         0,
         MAX_HEALTH,
         MAX_LIVES,
@@ -84,6 +131,8 @@ int start() {
     blackboard.input_manager.track(SDL_SCANCODE_0);
 
 
+    blackboard.shader_manager.set_cache_dir(shader_cache_path);
+
     blackboard.shader_manager.load_shader(
             shaders_path("sprite.vs.glsl"),
             shaders_path("sprite.fs.glsl"),"sprite");
@@ -138,85 +187,112 @@ int start() {
             shaders_path("sprite.fs.glsl"),
             "shake");
 
-    blackboard.texture_manager.load_texture(textures_path("panda.png"), "panda");
-    blackboard.texture_manager.load_texture(textures_path("panda_sprite_sheet.png"), "panda_sprites");
-    blackboard.texture_manager.load_texture(textures_path("grass_block_1.png"), "platform1");
-    blackboard.texture_manager.load_texture(textures_path("platform_center_grass.png"), "platform_center_grass");
-    blackboard.texture_manager.load_texture(textures_path("grass_block_2.png"), "platform2");
-    blackboard.texture_manager.load_texture(textures_path("bread_sprite_sheet.png"), "bread");
-
-    blackboard.texture_manager.load_texture(textures_path("story_text.png"), "story_text");
-    blackboard.texture_manager.load_texture(textures_path("endless_jungle_text.png"), "endless_jungle_text");
-    blackboard.texture_manager.load_texture(textures_path("endless_sky_text.png"), "endless_sky_text");
-    blackboard.texture_manager.load_texture(textures_path("jacko_text.png"), "jacko_text");
-    blackboard.texture_manager.load_texture(textures_path("pixel.png"), "pixel");
-    blackboard.texture_manager.load_texture(textures_path("menu_full.png"), "splash");
-    blackboard.texture_manager.load_texture(textures_path("ghost_sprite_sheet.png"), "ghost");
-    blackboard.texture_manager.load_texture(textures_path("llama_sprite_sheet.png"), "llama");
-    blackboard.texture_manager.load_texture(textures_path("spit_sprite_sheet.png"), "spit");
-    blackboard.texture_manager.load_texture(textures_path("bg_back.png"), "bg_back");
-    blackboard.texture_manager.load_texture(textures_path("bg_front.png"), "bg_front");
-    blackboard.texture_manager.load_texture(textures_path("bg_middle.png"), "bg_middle");
-    blackboard.texture_manager.load_texture(textures_path("bg_top.png"), "bg_top");
-    blackboard.texture_manager.load_texture(textures_path("pause_menu.png"), "pause_menu");
-    blackboard.texture_manager.load_texture(textures_path("dracula_sprite_sheet.png"), "dracula");
-    blackboard.texture_manager.load_texture(textures_path("boss_bats.png"), "bat");
-    blackboard.texture_manager.load_texture(textures_path("jacko_sprite_sheet.png"), "jacko");
-    blackboard.texture_manager.load_texture(textures_path("burger.png"), "burger");
-
-    blackboard.texture_manager.load_texture(textures_path("stalagmite.png"), "stalagmite");
-
-    blackboard.texture_manager.load_texture(textures_path("clouds_1.png"), "clouds1");
-    blackboard.texture_manager.load_texture(textures_path("clouds_2.png"), "clouds2");
-    blackboard.texture_manager.load_texture(textures_path("sky_bg.png"), "horizon");
-
-    blackboard.texture_manager.load_texture(textures_path("bg_grave_back.png"), "grave_back");
-    blackboard.texture_manager.load_texture(textures_path("bg_grave_front.png"), "grave_front");
-    blackboard.texture_manager.load_texture(textures_path("bg_grave_top.png"), "grave_top");
-    blackboard.texture_manager.load_texture(textures_path("bg_grave_mid.png"), "grave_middle");
-
-    blackboard.texture_manager.load_texture(textures_path("vial.png"), "vial");
-    blackboard.texture_manager.load_texture(textures_path("shield.png"), "shield");
+    blackboard.shader_manager.load_shader(
+            shaders_path("sprite.vs.glsl"),
+            shaders_path("blur.fs.glsl"),
+            "blur");
+
+    blackboard.shader_manager.load_shader(
+            shaders_path("sprite.vs.glsl"),
+            shaders_path("edge.fs.glsl"),
+            "edge");
+
+    blackboard.shader_manager.load_shader(
+            shaders_path("sprite.vs.glsl"),
+            shaders_path("glow.fs.glsl"),
+            "glow");
+
+    blackboard.shader_manager.print_cache_stats();
+    printf("startup: shaders loaded at %.1fms\n", startup_ms());
+
+    blackboard.texture_manager.open_pack(texture_pack_path);
+    Level::open_pack(level_pack_path);
+
+    // shared textures load now, scene specific ones are registered below and
+    // loaded by the scene manager from each scene's texture manifest
+
+    blackboard.texture_manager.load_texture_async(textures_path("panda.png"), "panda");
+    blackboard.texture_manager.load_texture_async(textures_path("panda_sprite_sheet.png"), "panda_sprites");
+    blackboard.texture_manager.load_texture_async(textures_path("grass_block_1.png"), "platform1");
+    blackboard.texture_manager.load_texture_async(textures_path("platform_center_grass.png"), "platform_center_grass");
+    blackboard.texture_manager.load_texture_async(textures_path("grass_block_2.png"), "platform2");
+    blackboard.texture_manager.load_texture_async(textures_path("bread_sprite_sheet.png"), "bread");
+
+    blackboard.texture_manager.load_texture_async(textures_path("story_text.png"), "story_text");
+    blackboard.texture_manager.load_texture_async(textures_path("endless_jungle_text.png"), "endless_jungle_text");
+    blackboard.texture_manager.load_texture_async(textures_path("endless_sky_text.png"), "endless_sky_text");
+    blackboard.texture_manager.load_texture_async(textures_path("jacko_text.png"), "jacko_text");
+    blackboard.texture_manager.load_texture_async(textures_path("pixel.png"), "pixel");
+    blackboard.texture_manager.load_texture_async(textures_path("menu_full.png"), "splash");
+    blackboard.texture_manager.load_texture_async(textures_path("ghost_sprite_sheet.png"), "ghost");
+    blackboard.texture_manager.load_texture_async(textures_path("llama_sprite_sheet.png"), "llama");
+    blackboard.texture_manager.load_texture_async(textures_path("spit_sprite_sheet.png"), "spit");
+    blackboard.texture_manager.register_texture(textures_path("bg_back.png"), "bg_back");
+    blackboard.texture_manager.register_texture(textures_path("bg_front.png"), "bg_front");
+    blackboard.texture_manager.register_texture(textures_path("bg_middle.png"), "bg_middle");
+    blackboard.texture_manager.register_texture(textures_path("bg_top.png"), "bg_top");
+    blackboard.texture_manager.load_texture_async(textures_path("pause_menu.png"), "pause_menu");
+    blackboard.texture_manager.register_texture(textures_path("dracula_sprite_sheet.png"), "dracula");
+    blackboard.texture_manager.load_texture_async(textures_path("boss_bats.png"), "bat");
+    blackboard.texture_manager.register_texture(textures_path("jacko_sprite_sheet.png"), "jacko");
+    blackboard.texture_manager.load_texture_async(textures_path("burger.png"), "burger");
+
+    blackboard.texture_manager.load_texture_async(textures_path("stalagmite.png"), "stalagmite");
+
+    blackboard.texture_manager.register_texture(textures_path("clouds_1.png"), "clouds1");
+    blackboard.texture_manager.register_texture(textures_path("clouds_2.png"), "clouds2");
+    blackboard.texture_manager.register_texture(textures_path("sky_bg.png"), "horizon");
+
+    blackboard.texture_manager.register_texture(textures_path("bg_grave_back.png"), "grave_back");
+    blackboard.texture_manager.register_texture(textures_path("bg_grave_front.png"), "grave_front");
+    blackboard.texture_manager.register_texture(textures_path("bg_grave_top.png"), "grave_top");
+    blackboard.texture_manager.register_texture(textures_path("bg_grave_mid.png"), "grave_middle");
+
+    blackboard.texture_manager.load_texture_async(textures_path("vial.png"), "vial");
+    blackboard.texture_manager.load_texture_async(textures_path("shield.png"), "shield");
   
-    blackboard.texture_manager.load_texture(textures_path("story_beach_back.png"), "beach_back");
-    blackboard.texture_manager.load_texture(textures_path("story_beach_front.png"), "beach_front");
-    blackboard.texture_manager.load_texture(textures_path("story_beach_water_1.png"), "beach_water_1");
-    blackboard.texture_manager.load_texture(textures_path("story_beach_water_2.png"), "beach_water_2");
-    blackboard.texture_manager.load_texture(textures_path("story_beach_water_3.png"), "beach_water_3");
-    blackboard.texture_manager.load_texture(textures_path("story_beach_water_4.png"), "beach_water_4");
-    blackboard.texture_manager.load_texture(textures_path("story_beach_kelly.png"), "beach_kelly");
-    blackboard.texture_manager.load_texture(textures_path("story_beach_panda.png"), "beach_panda");
-    blackboard.texture_manager.load_texture(textures_path("story_beach_hearts.png"), "beach_hearts");
-    blackboard.texture_manager.load_texture(textures_path("story_beach_jacko.png"), "beach_jacko");
-    blackboard.texture_manager.load_texture(textures_path("skip_scene.png"), "skip_scene");
-
-
-    blackboard.texture_manager.load_texture(textures_path("castle_back.png"), "castle_back");
-    blackboard.texture_manager.load_texture(textures_path("castle_front.png"), "castle_front");
-
-
-    blackboard.texture_manager.load_texture(textures_path("story_jungle_background.png"), "story_jungle_background");
-    blackboard.texture_manager.load_texture(textures_path("story_jungle_panda.png"), "story_jungle_panda");
-    blackboard.texture_manager.load_texture(textures_path("story_jungle_kelly.png"), "story_jungle_kelly");
-    blackboard.texture_manager.load_texture(textures_path("story_jungle_grass.png"), "story_jungle_grass");
-    blackboard.texture_manager.load_texture(textures_path("story_jungle_vape.png"), "story_jungle_vape");
-
-    blackboard.texture_manager.load_texture(textures_path("story_end_background.png"), "story_end_background");
-    blackboard.texture_manager.load_texture(textures_path("story_end_kelly.png"), "story_end_kelly");
-    blackboard.texture_manager.load_texture(textures_path("story_ending_panda_sprite_sheet.png"), "story_ending_panda");
-
-    blackboard.texture_manager.load_texture(textures_path("solid_block_1.png"), "solid_block_1");
-    blackboard.texture_manager.load_texture(textures_path("solid_block_2.png"), "solid_block_2");
-    blackboard.texture_manager.load_texture(textures_path("falling_blocks_1.png"), "falling_blocks_1");
-    blackboard.texture_manager.load_texture(textures_path("falling_blocks_2.png"), "falling_blocks_2");
-    blackboard.texture_manager.load_texture(textures_path("dirt_1.png"), "dirt_1");
-    blackboard.texture_manager.load_texture(textures_path("dirt_2.png"), "dirt_2");
-    blackboard.texture_manager.load_texture(textures_path("grass_1.png"), "grass_1");
-    blackboard.texture_manager.load_texture(textures_path("grass_2.png"), "grass_2");
-    blackboard.texture_manager.load_texture(textures_path("cave_entrance.png"), "cave_entrance");
-
-    blackboard.texture_manager.load_texture(textures_path("tutorial_button.png"), "tutorial_button");
-    blackboard.texture_manager.load_texture(textures_path("tutorial.png"), "tutorial");
+    blackboard.texture_manager.register_texture(textures_path("story_beach_back.png"), "beach_back");
+    blackboard.texture_manager.register_texture(textures_path("story_beach_front.png"), "beach_front");
+    blackboard.texture_manager.register_texture(textures_path("story_beach_water_1.png"), "beach_water_1");
+    blackboard.texture_manager.register_texture(textures_path("story_beach_water_2.png"), "beach_water_2");
+    blackboard.texture_manager.register_texture(textures_path("story_beach_water_3.png"), "beach_water_3");
+    blackboard.texture_manager.register_texture(textures_path("story_beach_water_4.png"), "beach_water_4");
+    blackboard.texture_manager.register_texture(textures_path("story_beach_kelly.png"), "beach_kelly");
+    blackboard.texture_manager.register_texture(textures_path("story_beach_panda.png"), "beach_panda");
+    blackboard.texture_manager.register_texture(textures_path("story_beach_hearts.png"), "beach_hearts");
+    blackboard.texture_manager.register_texture(textures_path("story_beach_jacko.png"), "beach_jacko");
+    blackboard.texture_manager.load_texture_async(textures_path("skip_scene.png"), "skip_scene");
+
+
+    blackboard.texture_manager.register_texture(textures_path("castle_back.png"), "castle_back");
+    blackboard.texture_manager.register_texture(textures_path("castle_front.png"), "castle_front");
+
+
+    blackboard.texture_manager.register_texture(textures_path("story_jungle_background.png"), "story_jungle_background");
+    blackboard.texture_manager.register_texture(textures_path("story_jungle_panda.png"), "story_jungle_panda");
+    blackboard.texture_manager.register_texture(textures_path("story_jungle_kelly.png"), "story_jungle_kelly");
+    blackboard.texture_manager.register_texture(textures_path("story_jungle_grass.png"), "story_jungle_grass");
+    blackboard.texture_manager.register_texture(textures_path("story_jungle_vape.png"), "story_jungle_vape");
+
+    blackboard.texture_manager.register_texture(textures_path("story_end_background.png"), "story_end_background");
+    blackboard.texture_manager.register_texture(textures_path("story_end_kelly.png"), "story_end_kelly");
+    blackboard.texture_manager.register_texture(textures_path("story_ending_panda_sprite_sheet.png"), "story_ending_panda");
+
+    blackboard.texture_manager.load_texture_async(textures_path("solid_block_1.png"), "solid_block_1");
+    blackboard.texture_manager.load_texture_async(textures_path("solid_block_2.png"), "solid_block_2");
+    blackboard.texture_manager.load_texture_async(textures_path("falling_blocks_1.png"), "falling_blocks_1");
+    blackboard.texture_manager.load_texture_async(textures_path("falling_blocks_2.png"), "falling_blocks_2");
+    blackboard.texture_manager.load_texture_async(textures_path("dirt_1.png"), "dirt_1");
+    blackboard.texture_manager.load_texture_async(textures_path("dirt_2.png"), "dirt_2");
+    blackboard.texture_manager.load_texture_async(textures_path("grass_1.png"), "grass_1");
+    blackboard.texture_manager.load_texture_async(textures_path("grass_2.png"), "grass_2");
+    blackboard.texture_manager.load_texture_async(textures_path("cave_entrance.png"), "cave_entrance");
+
+    blackboard.texture_manager.load_texture_async(textures_path("tutorial_button.png"), "tutorial_button");
+    blackboard.texture_manager.load_texture_async(textures_path("tutorial.png"), "tutorial");
+
+    printf("startup: %zu textures queued at %.1fms\n",
+           blackboard.texture_manager.pending_count(), startup_ms());
 
     blackboard.mesh_manager.load_mesh("health", 4, HealthBar::vertices, 6, HealthBar::indices);
     blackboard.mesh_manager.load_mesh("cave", 41, Cave::vertices, 168, Cave::indices);
@@ -237,63 +313,189 @@ int start() {
     scene_manager.add_scene(MAIN_MENU_SCENE_ID, (Scene*)(&main_menu));
 
 
-    // initialize scenes here
-
-
-    HorizontalScene horizontal_scene(blackboard, scene_manager);
-    horizontal_scene.set_high_score(std::stoi(scores.get("jungle")));
-
-    BossScene boss_scene(blackboard, scene_manager);
-    DraculaBossScene dracula_boss_scene(blackboard, scene_manager);
-
-    VerticalScene vertical_scene(blackboard, scene_manager);
-    vertical_scene.set_high_score(std::stoi(scores.get("sky")));
-
-    StoryIntroBeachScene story_beach_intro_scene(blackboard, scene_manager);
-
-    StoryIntroJungleScene story_jungle_intro_scene(blackboard, scene_manager);
-
-    StoryEndScene story_end_scene(blackboard, scene_manager);
-
-    scene_manager.add_scene(STORY_EASY_JUNGLE_SCENE_ID, (Scene*)(&horizontal_scene), STORY_EASY);
-    scene_manager.add_scene(ENDLESS_JUNGLE_SCENE_ID, (Scene*)(&horizontal_scene), ENDLESS);
-    scene_manager.add_scene(ENDLESS_SKY_SCENE_ID, (Scene*)(&vertical_scene), ENDLESS);
-    scene_manager.add_scene(BOSS_SCENE_ID, (Scene*)(&boss_scene), JACKO);
-    scene_manager.add_scene(DRACULA_BOSS_SCENE_ID, (Scene*)(&dracula_boss_scene), DRACULA);
-    scene_manager.add_scene(STORY_BEACH_INTRO_SCENE_ID, (Scene*)(&story_beach_intro_scene), STORY_EASY);
-    scene_manager.add_scene(STORY_JUNGLE_INTRO_SCENE_ID, (Scene*)(&story_jungle_intro_scene), STORY_EASY);
-    scene_manager.add_scene(STORY_EASY_SKY_SCENE_ID, (Scene*)(&vertical_scene), STORY_EASY);
-    scene_manager.add_scene(STORY_HARD_JUNGLE_SCENE_ID, (Scene*)(&horizontal_scene), STORY_HARD);
-    scene_manager.add_scene(STORY_HARD_SKY_SCENE_ID, (Scene*)(&vertical_scene), STORY_HARD);
-    scene_manager.add_scene(STORY_END_SCENE_ID, (Scene*)(&story_end_scene), STORY_EASY);
+    // the other scenes are built the first time they're entered or prepared, the level scenes
+    // carry their high scores out through their teardowns
+    scene_manager.set_lifetime(teardown_scenes ? TEAR_DOWN_LEFT_SCENES : KEEP_BUILT_SCENES);
+    int jungle_high_score = std::stoi(scores.get("jungle"));
+    int sky_high_score = std::stoi(scores.get("sky"));
+
+    int horizontal_scene = scene_manager.add_scene_factory(
+        [&blackboard, &scene_manager, &jungle_high_score]() {
+            auto scene = new HorizontalScene(blackboard, scene_manager);
+            scene->set_high_score(jungle_high_score);
+            return std::unique_ptr<Scene>(scene);
+        },
+        [&jungle_high_score](Scene& scene) {
+            jungle_high_score = static_cast<HorizontalScene&>(scene).get_high_score();
+        });
+    int vertical_scene = scene_manager.add_scene_factory(
+        [&blackboard, &scene_manager, &sky_high_score]() {
+            auto scene = new VerticalScene(blackboard, scene_manager);
+            scene->set_high_score(sky_high_score);
+            return std::unique_ptr<Scene>(scene);
+        },
+        [&sky_high_score](Scene& scene) {
+            sky_high_score = static_cast<VerticalScene&>(scene).get_high_score();
+        });
+    int boss_scene = scene_manager.add_scene_factory([&blackboard, &scene_manager]() {
+        return std::unique_ptr<Scene>(new BossScene(blackboard, scene_manager));
+    });
+    int dracula_boss_scene = scene_manager.add_scene_factory([&blackboard, &scene_manager]() {
+        return std::unique_ptr<Scene>(new DraculaBossScene(blackboard, scene_manager));
+    });
+    int story_beach_intro_scene = scene_manager.add_scene_factory([&blackboard, &scene_manager]() {
+        return std::unique_ptr<Scene>(new StoryIntroBeachScene(blackboard, scene_manager));
+    });
+    int story_jungle_intro_scene = scene_manager.add_scene_factory([&blackboard, &scene_manager]() {
+        return std::unique_ptr<Scene>(new StoryIntroJungleScene(blackboard, scene_manager));
+    });
+    int story_end_scene = scene_manager.add_scene_factory([&blackboard, &scene_manager]() {
+        return std::unique_ptr<Scene>(new StoryEndScene(blackboard, scene_manager));
+    });
+
+    scene_manager.add_scene(STORY_EASY_JUNGLE_SCENE_ID, horizontal_scene, STORY_EASY);
+    scene_manager.add_scene(ENDLESS_JUNGLE_SCENE_ID, horizontal_scene, ENDLESS);
+    scene_manager.add_scene(ENDLESS_SKY_SCENE_ID, vertical_scene, ENDLESS);
+    scene_manager.add_scene(BOSS_SCENE_ID, boss_scene, JACKO);
+    scene_manager.add_scene(DRACULA_BOSS_SCENE_ID, dracula_boss_scene, DRACULA);
+    scene_manager.add_scene(STORY_BEACH_INTRO_SCENE_ID, story_beach_intro_scene, STORY_EASY);
+    scene_manager.add_scene(STORY_JUNGLE_INTRO_SCENE_ID, story_jungle_intro_scene, STORY_EASY);
+    scene_manager.add_scene(STORY_EASY_SKY_SCENE_ID, vertical_scene, STORY_EASY);
+    scene_manager.add_scene(STORY_HARD_JUNGLE_SCENE_ID, horizontal_scene, STORY_HARD);
+    scene_manager.add_scene(STORY_HARD_SKY_SCENE_ID, vertical_scene, STORY_HARD);
+    scene_manager.add_scene(STORY_END_SCENE_ID, story_end_scene, STORY_EASY);
+
+    printf("startup: scenes registered at %.1fms\n", startup_ms());
+    scene_manager.print_scene_report();
+
+    std::vector<std::string> jungle_textures = {"bg_back", "bg_front", "bg_middle", "bg_top"};
+    std::vector<std::string> sky_textures = {"clouds1", "clouds2", "horizon"};
+    scene_manager.set_texture_manifest(STORY_EASY_JUNGLE_SCENE_ID, jungle_textures);
+    scene_manager.set_texture_manifest(ENDLESS_JUNGLE_SCENE_ID, jungle_textures);
+    scene_manager.set_texture_manifest(STORY_HARD_JUNGLE_SCENE_ID, jungle_textures);
+    scene_manager.set_texture_manifest(ENDLESS_SKY_SCENE_ID, sky_textures);
+    scene_manager.set_texture_manifest(STORY_EASY_SKY_SCENE_ID, sky_textures);
+    scene_manager.set_texture_manifest(STORY_HARD_SKY_SCENE_ID, sky_textures);
+    scene_manager.set_texture_manifest(BOSS_SCENE_ID,
+            {"jacko", "grave_back", "grave_front", "grave_middle", "grave_top"});
+    scene_manager.set_texture_manifest(DRACULA_BOSS_SCENE_ID, {"dracula", "castle_back", "castle_front"});
+    scene_manager.set_texture_manifest(STORY_BEACH_INTRO_SCENE_ID,
+            {"beach_back", "beach_front", "beach_water_1", "beach_water_2", "beach_water_3", "beach_water_4",
+             "beach_kelly", "beach_panda", "beach_hearts", "beach_jacko"});
+    scene_manager.set_texture_manifest(STORY_JUNGLE_INTRO_SCENE_ID,
+            {"story_jungle_background", "story_jungle_panda", "story_jungle_kelly", "story_jungle_grass",
+             "story_jungle_vape"});
+    scene_manager.set_texture_manifest(STORY_END_SCENE_ID,
+            {"story_end_background", "story_end_kelly", "story_ending_panda"});
 
     // set the first scene
 
     scene_manager.change_scene(MAIN_MENU_SCENE_ID);
 
-    blackboard.post_process_shader = std::make_unique<Shader>(blackboard.shader_manager.get_shader("sprite"));
-
+    auto sprite_shader = blackboard.shader_manager.handle(SPRITE_SHADER);
+    auto sprite_mesh = blackboard.mesh_manager.handle(SPRITE_MESH);
+    bool first_frame = true;
+    bool textures_done = false;
     bool quit = false;
+    FrameStats frame_stats;
+    SceneID stats_scene = scene_manager.current_scene_;
+    uint64_t frame_start = SDL_GetPerformanceCounter();
+
+    InputRecorder recorder;
+    if (record_path != nullptr) {
+        recorder.open(record_path, seed, blackboard.input_manager.tracked_keys());
+    }
+    // covers what the player can change, a replay that drifts shows up here within a frame or two
+    auto state_hash = [&blackboard, &scene_manager]() {
+        vec2 camera = blackboard.camera.position();
+        uint64_t hash = hash_bytes(&camera, sizeof(camera));
+        hash = hash_bytes(&blackboard.score, sizeof(blackboard.score), hash);
+        hash = hash_bytes(&blackboard.story_lives, sizeof(blackboard.story_lives), hash);
+        hash = hash_bytes(&blackboard.story_health, sizeof(blackboard.story_health), hash);
+        hash = hash_bytes(&scene_manager.current_scene_, sizeof(scene_manager.current_scene_), hash);
+        return (uint32_t) hash;
+    };
+
     while (!quit) {
+        // nothing from last frame's update or render is alive any more
+        FrameArena::instance().reset();
+        uint64_t now = SDL_GetPerformanceCounter();
+        float frame_ms = (now - frame_start) * 1000.f / SDL_GetPerformanceFrequency();
+        frame_start = now;
+
+        // frame times are reported per scene so streaming hitches in the level scenes stand out
+        if (scene_manager.current_scene_ != stats_scene) {
+            frame_stats.print("scene", stats_scene);
+            frame_stats.reset();
+            stats_scene = scene_manager.current_scene_;
+        }
+        if (!first_frame) {
+            frame_stats.record(frame_ms);
+        }
+        blackboard.texture_manager.upload_pending(TEXTURE_UPLOADS_PER_FRAME);
+
         //update blackboard
-        blackboard.delta_time = std::min<float>(window.delta_time(), 0.25f) * blackboard.time_multiplier;
-        blackboard.input_manager.update();
+        float delta_time;
+        const Uint8* keyboard;
+        if (replay.is_open()) {
+            if (!replay.next()) {
+                break;
+            }
+            delta_time = replay.delta_time();
+            keyboard = replay.keyboard();
+        } else {
+            delta_time = std::min<float>(window.delta_time(), 0.25f);
+            keyboard = SDL_GetKeyboardState(NULL);
+        }
+        uint32_t pressed = recorder.pack(keyboard);
+        blackboard.delta_time = delta_time * blackboard.time_multiplier;
+        blackboard.input_manager.update(keyboard);
 
         scene_manager.update(blackboard);
 
-        window.clear();
-        scene_manager.render(blackboard);
-
-        window.display(
-            *blackboard.post_process_shader,
-            blackboard.mesh_manager.get_mesh("sprite")
-        );
+        if (replay.is_open()) {
+            replay.check(state_hash());
+        }
+        recorder.record(delta_time, pressed, state_hash());
+
+        if (!headless) {
+            window.clear();
+            scene_manager.render(blackboard);
+
+            window.display(
+                blackboard.post_process_chain,
+                blackboard.shader_manager.get_shader(sprite_shader),
+                blackboard.mesh_manager.get_mesh(sprite_mesh)
+            );
+        }
+
+        if (first_frame) {
+            printf("startup: first menu frame at %.1fms\n", startup_ms());
+            first_frame = false;
+        }
+        if (!textures_done && blackboard.texture_manager.pending_count() == 0) {
+            printf("startup: all textures uploaded at %.1fms\n", startup_ms());
+            blackboard.texture_manager.print_load_stats();
+            textures_done = true;
+        }
 
         quit = blackboard.input_manager.should_exit();
     }
-    scores.put("jungle", std::to_string(horizontal_scene.get_high_score()));
-    scores.put("sky", std::to_string(vertical_scene.get_high_score()));
-    scores.save();
+    frame_stats.print("scene", stats_scene);
+    blackboard.commands.print_stats();
+    FrameArena::instance().print_stats();
+    recorder.close();
+    blackboard.soundManager.printReport();
+    scene_manager.print_scene_report();
+    scene_manager.teardown_all();
+    if (replay.is_open()) {
+        replay.print_report();
+    } else {
+        // a replay reproduces scores that were already saved when it was recorded
+        scores.put("jungle", std::to_string(jungle_high_score));
+        scores.put("sky", std::to_string(sky_high_score));
+        scores.save();
+    }
     window.destroy();
     return 0;
 }
@@ -302,7 +504,7 @@ int main(int argc, char** argv) {
     int init = !SDL_Init(0);
 
     if (init) {
-        int result = start();
+        int result = start(argc, argv);
         SDL_Quit();
 
         return result;
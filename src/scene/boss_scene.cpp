@@ -17,7 +17,7 @@ BossScene::BossScene(Blackboard &blackboard, SceneManager &scene_manager) :
         player_animation_system(BOSS_TYPE),
         timer_system(),
         panda_dmg_system(),
-        falling_platform_system(),
+        falling_platform_system(timer_system),
         enemy_animation_system(),
         health_bar_transform_system(),
         fade_overlay_system(),
@@ -25,12 +25,36 @@ BossScene::BossScene(Blackboard &blackboard, SceneManager &scene_manager) :
         hud_transform_system(),
         transition_system(BOSS_TYPE)
 {
+    schedule_systems();
     init_scene(blackboard);
     reset_scene(blackboard); // idk why??? but this is required
     create_fade_overlay(blackboard);
     gl_has_errors();
 }
 
+void BossScene::schedule_systems() {
+    scheduler_.add_system("level", level_system);
+    scheduler_.add_system("chase", chase_system);
+    scheduler_.add_system("physics", physics_system);
+    scheduler_.add_system("panda_damage", panda_dmg_system);
+    scheduler_.add_system("health_bar_transform", health_bar_transform_system,
+                          health_bar_transform_system.access());
+    scheduler_.add_system("jacko_ai", jacko_ai_system);
+    scheduler_.add_system("sprite_transform", sprite_transform_system, sprite_transform_system.access());
+    scheduler_.add_system("player_animation", player_animation_system, player_animation_system.access());
+    scheduler_.add_system("enemy_animation", enemy_animation_system, enemy_animation_system.access());
+    scheduler_.add_system("transition", transition_system);
+    scheduler_.add_system("timer", timer_system, timer_system.access());
+    // the scene's own timer isn't in the registry, nothing else scheduled touches it
+    scheduler_.add_step("scene_timer", [this](Blackboard &blackboard, entt::DefaultRegistry &registry) {
+        scene_timer.update(blackboard.delta_time);
+    }, SystemAccess());
+    scheduler_.add_system("falling_platform", falling_platform_system);
+    scheduler_.add_system("background_transform", background_transform_system,
+                          background_transform_system.access());
+    scheduler_.add_system("hud_transform", hud_transform_system, hud_transform_system.access()); // should run last
+}
+
 void BossScene::update(Blackboard &blackboard) {
     if (!initialized) {
         initial_update(blackboard);
@@ -40,6 +64,7 @@ void BossScene::update(Blackboard &blackboard) {
     auto &fadeOverlay = registry_.get<FadeOverlay>(fade_overlay_entity);
     if (blackboard.camera.transition_ready) {
         if (fadeOverlay.alpha() < 1.2f) {
+            prepare_scene(STORY_HARD_JUNGLE_SCENE_ID);
             fade_overlay_system.update(blackboard, registry_);
         } else {
             go_to_next_scene(blackboard);
@@ -88,21 +113,7 @@ void BossScene::update(Blackboard &blackboard) {
 
         update_panda(blackboard);
 
-        level_system.update(blackboard, registry_);
-        chase_system.update(blackboard, registry_);
-        physics_system.update(blackboard, registry_);
-        panda_dmg_system.update(blackboard, registry_);
-        health_bar_transform_system.update(blackboard, registry_);
-        jacko_ai_system.update(blackboard, registry_);
-        sprite_transform_system.update(blackboard, registry_);
-        player_animation_system.update(blackboard, registry_);
-        enemy_animation_system.update(blackboard, registry_);
-        transition_system.update(blackboard, registry_);
-        timer_system.update(blackboard, registry_);
-        scene_timer.update(blackboard.delta_time);
-        falling_platform_system.update(blackboard, registry_);
-        background_transform_system.update(blackboard, registry_);
-        hud_transform_system.update(blackboard, registry_); // should run last
+        scheduler_.run(blackboard, registry_);
     } else {
         pause_menu_transform_system.update(blackboard, registry_);
     }
@@ -162,7 +173,7 @@ void BossScene::init_scene(Blackboard &blackboard) {
     auto &fadeOverlay = registry_.get<FadeOverlay>(fade_overlay_entity);
     fadeOverlay.set_alpha(1.0);
     level_system.init(registry_);
-    blackboard.post_process_shader = std::make_unique<Shader>(blackboard.shader_manager.get_shader("sprite"));
+    blackboard.post_process_chain.clear();
 }
 
 void BossScene::initial_update(Blackboard &blackboard) {
@@ -181,6 +192,7 @@ void BossScene::reset_scene(Blackboard &blackboard) {
 }
 
 void BossScene::cleanup() {
+    scheduler_.print_report("boss");
     level_system.destroy_entities(registry_);
     registry_.destroy(jacko_entity);
     for (uint32_t e: bg_entities) {
@@ -289,7 +301,7 @@ void BossScene::generate_cave(float x, float y, Blackboard &blackboard, entt::De
 }
 
 void BossScene::update_cave(Blackboard &blackboard, entt::DefaultRegistry &registry, int speed){
-    if (scene_timer.exists("SHAKE")) {
+    if (scene_timer.exists(SHAKE_TIMER_LABEL)) {
         auto cave_view = registry.view<Cave, Transform>();
         for (auto cave_entity : cave_view) {
             auto &cave = cave_view.get<Cave>(cave_entity);
@@ -313,23 +325,19 @@ void BossScene::update_cave(Blackboard &blackboard, entt::DefaultRegistry &regis
 }
 
 void BossScene::create_shake_effect(Blackboard &blackboard) {
-    scene_timer.save_watch("SHAKE", SHAKE);
-    blackboard.post_process_shader = std::make_unique<Shader>(
-            blackboard.shader_manager.get_shader("shake"));
+    scene_timer.save_watch(SHAKE_TIMER_LABEL, SHAKE);
+    blackboard.post_process_chain.add_pass("SHAKE", blackboard.shader_manager.get_shader("shake"));
 }
 
 void BossScene::update_shake_effect(Blackboard &blackboard) {
-    if (scene_timer.exists("SHAKE")) {
-        float val = ((3*(scene_timer.get_target_time("SHAKE") - scene_timer.get_curr_time()) /
+    if (scene_timer.exists(SHAKE_TIMER_LABEL)) {
+        float val = ((3*(scene_timer.get_target_time(SHAKE_TIMER_LABEL) - scene_timer.get_curr_time()) /
                       SHAKE)); // Ratio of time done (Ranges from [1...0])
-        blackboard.post_process_shader->bind();
-        blackboard.post_process_shader->set_uniform_float("time", val);
-        blackboard.post_process_shader->unbind();
+        blackboard.post_process_chain.set_uniform_float("SHAKE", "time", val);
         // Setup new timeElapsed Uniform
-        if (scene_timer.is_done("SHAKE")) {
-            blackboard.post_process_shader = std::make_unique<Shader>(
-                    blackboard.shader_manager.get_shader("sprite"));
-            scene_timer.remove("SHAKE");
+        if (scene_timer.is_done(SHAKE_TIMER_LABEL)) {
+            blackboard.post_process_chain.remove_pass("SHAKE");
+            scene_timer.remove(SHAKE_TIMER_LABEL);
         }
     }
 }
\ No newline at end of file
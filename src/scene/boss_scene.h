@@ -17,6 +17,7 @@
 #include <systems/fade_overlay_system.h>
 #include <systems/pause_menu_transform_system.h>
 #include <systems/hud_transform_system.h>
+#include <systems/system_scheduler.h>
 #include <systems/render_system.h>
 #include "../systems/sprite_transform_system.h"
 #include "../util/blackboard.h"
@@ -39,7 +40,8 @@ private:
     bool initialized = false;
     std::vector<uint32_t> bg_entities;
     uint32_t jacko_entity;
-    const std::string SHAKE_LABEL = "STROBE";
+    const TimerLabel SHAKE_LABEL = Timer::label("STROBE");
+    const TimerLabel SHAKE_TIMER_LABEL = Timer::label("SHAKE");
     const float SHAKE = 2.f;
 
     BossLevelSystem level_system;
@@ -61,8 +63,10 @@ private:
     RenderSystem render_system;
     TransitionSystem transition_system;
     Timer scene_timer;
+    SystemScheduler scheduler_;
 
 
+    void schedule_systems();
     void create_background(Blackboard &blackboard);
     void create_jacko(Blackboard& blackboard, uint32_t panda);
     void update_panda(Blackboard& blackboard);
@@ -17,7 +17,7 @@ DraculaBossScene::DraculaBossScene(Blackboard &blackboard, SceneManager &scene_m
         player_animation_system(BOSS_TYPE),
         timer_system(),
         panda_dmg_system(),
-        falling_platform_system(),
+        falling_platform_system(timer_system),
         enemy_animation_system(),
         health_bar_transform_system(),
         fade_overlay_system(),
@@ -60,6 +60,7 @@ void DraculaBossScene::update(Blackboard &blackboard) {
 
     if (dracula_health.health_points <= 0 && !blackboard.camera.in_transition) {
         if (fade_overlay.alpha() < 1.6f) {
+            prepare_scene(STORY_END_SCENE_ID);
             fade_overlay_system.update(blackboard, registry_);
         } else {
             blackboard.camera.set_position(0, 0);
@@ -149,6 +150,10 @@ void DraculaBossScene::init_scene(Blackboard &blackboard) {
     level_system.init(registry_);
 }
 
+void DraculaBossScene::prepare(SceneMode mode, Blackboard &blackboard) {
+    dracula_ai_system.a_star_system.prepareGrid();
+}
+
 void DraculaBossScene::reset_scene(Blackboard &blackboard) {
     cleanup();
     init_scene(blackboard);
@@ -77,6 +77,9 @@ public:
     void init_scene(Blackboard &blackboard);
     void reset_scene(Blackboard& blackboard) override;
 
+    // builds the pathfinding grid while the sky scene fades out, init_scene() takes it
+    void prepare(SceneMode mode, Blackboard& blackboard) override;
+
     void cleanup();
 };
 
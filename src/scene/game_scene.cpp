@@ -66,9 +66,7 @@ void GameScene::create_high_score_text(Blackboard &blackboard, int high_score) {
     auto mesh = blackboard.mesh_manager.get_mesh("sprite");
 
     auto high_score_entity = registry_.create();
-    std::stringstream ss;
-    ss << ". " << std::setfill('0') << std::setw(7) << high_score << ".";
-    auto &text2 = registry_.assign<Text>(high_score_entity, shader, mesh, font, ss.str());
+    auto &text2 = registry_.assign<Text>(high_score_entity, shader, mesh, font, high_score_text(high_score));
     text2.set_scale(0.8f);
     registry_.assign<HudElement>(high_score_entity,
                                  vec2{blackboard.camera.size().x / 2.0f - HUD_HEALTH_X_OFFSET,
@@ -80,7 +78,7 @@ void GameScene::create_lives_text(Blackboard &blackboard) {
     FontType font = blackboard.fontManager.get_font("titillium_72");
     auto shader = blackboard.shader_manager.get_shader("text");
     auto mesh = blackboard.mesh_manager.get_mesh("sprite");
-    std::string textVal = "LI VES:   " + std::to_string(blackboard.story_lives);
+    std::string textVal = lives_text(blackboard);
 
     auto lives_entity = registry_.create();
     auto &text = registry_.assign<Text>(lives_entity, shader, mesh, font, textVal);
@@ -91,6 +89,16 @@ void GameScene::create_lives_text(Blackboard &blackboard) {
     registry_.assign<Layer>(lives_entity, TEXT_LAYER);
 }
 
+std::string GameScene::high_score_text(int high_score) {
+    std::stringstream ss;
+    ss << ". " << std::setfill('0') << std::setw(7) << high_score << ".";
+    return ss.str();
+}
+
+std::string GameScene::lives_text(const Blackboard &blackboard) {
+    return "LI VES:   " + std::to_string(blackboard.story_lives);
+}
+
 void GameScene::create_fade_overlay(Blackboard &blackboard) {
     fade_overlay_entity = registry_.create();
     auto shaderFade = blackboard.shader_manager.get_shader("fade");
@@ -119,4 +127,58 @@ void GameScene::cleanup() {
     registry_.destroy<Panda>();
     registry_.destroy<FadeOverlay>();
     registry_.destroy<Text>();
-}
\ No newline at end of file
+}
+
+void GameScene::reset_blackboard(Blackboard &blackboard) {
+    blackboard.camera.in_transition = false;
+    blackboard.camera.transition_ready = false;
+    blackboard.score = 0;
+    blackboard.soundManager.changeBackgroundMusic(blackboard.soundManager.currentStage);
+}
+
+void GameScene::begin_scene(Blackboard &blackboard) {
+    blackboard.randNumGenerator.init(0);
+    blackboard.camera.set_position(CAMERA_START_X, CAMERA_START_Y);
+    blackboard.camera.compose();
+    blackboard.time_multiplier = DEFAULT_SPEED_MULTIPLIER;
+}
+
+void GameScene::capture_shell(const std::vector<uint32_t> &backgrounds, uint32_t timer_entity) {
+    shell_panda_ = panda_entity;
+    shell_fade_overlay_ = fade_overlay_entity;
+    shell_timer_ = timer_entity;
+    shell_backgrounds_ = backgrounds;
+
+    // the level was just torn down, so the only text left is the HUD's
+    std::vector<uint32_t> entities = backgrounds;
+    entities.push_back(panda_entity);
+    entities.push_back(fade_overlay_entity);
+    if (mode_ == STORY_EASY || mode_ == STORY_HARD) {
+        entities.push_back(timer_entity);
+    }
+    for (auto entity : registry_.view<Text>()) {
+        entities.push_back(entity);
+    }
+    shell_.capture(registry_, entities.begin(), entities.end());
+}
+
+void GameScene::restore_shell(Blackboard &blackboard, std::vector<uint32_t> &backgrounds, uint32_t &timer_entity,
+                              int high_score) {
+    shell_.restore(registry_);
+    panda_entity = shell_.restored(shell_panda_);
+    fade_overlay_entity = shell_.restored(shell_fade_overlay_);
+    for (auto entity : shell_backgrounds_) {
+        backgrounds.push_back(shell_.restored(entity));
+    }
+    if (mode_ == STORY_EASY || mode_ == STORY_HARD) {
+        timer_entity = shell_.restored(shell_timer_);
+        registry_.get<Health>(panda_entity).health_points = blackboard.story_health;
+    }
+    // the HUD text that isn't the score shows the high score or the lives left, both may have changed
+    for (auto entity : registry_.view<Text>()) {
+        if (!registry_.has<Score>(entity)) {
+            registry_.get<Text>(entity).set_text(
+                    mode_ == ENDLESS ? high_score_text(high_score) : lives_text(blackboard));
+        }
+    }
+}
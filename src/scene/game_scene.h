@@ -6,6 +6,8 @@
 #define PANDAEXPRESS_GAME_SCENE_H
 
 #include <iomanip>
+#include <string>
+#include <graphics/background.h>
 #include <graphics/fade_overlay.h>
 #include <graphics/health_bar.h>
 #include <graphics/text.h>
@@ -21,8 +23,14 @@
 #include <components/causes_damage.h>
 #include <components/velocity.h>
 #include <components/collidable.h>
+#include <components/layer.h>
+#include <util/registry_snapshot.h>
 #include "scene.h"
 
+// every component the entities built before a level (backgrounds, panda, HUD, overlay) can have
+using SceneShell = RegistrySnapshot<Transform, Sprite, Panda, ObeysGravity, Health, Interactable, CausesDamage,
+        Velocity, Timer, Collidable, Layer, HealthBar, HudElement, Text, Score, FadeOverlay, Background>;
+
 class GameScene : public Scene {
 protected:
     const float PANDA_START_X = -10.f;
@@ -41,6 +49,13 @@ protected:
     uint32_t pause_menu_entity;
     uint32_t fade_overlay_entity;
 
+    // what init_scene() builds ahead of the level, restored instead of rebuilt when the panda respawns
+    SceneShell shell_;
+    uint32_t shell_panda_;
+    uint32_t shell_fade_overlay_;
+    uint32_t shell_timer_;
+    std::vector<uint32_t> shell_backgrounds_;
+
     GameScene(SceneManager &manager);
 
     void create_panda(Blackboard &blackboard);
@@ -51,12 +66,32 @@ protected:
 
     void create_lives_text(Blackboard &blackboard);
 
+    static std::string high_score_text(int high_score);
+
+    static std::string lives_text(const Blackboard &blackboard);
+
     void create_fade_overlay(Blackboard &blackboard);
 
     void create_pause_menu(Blackboard &blackboard);
 
     void cleanup();
 
+    // the blackboard state a restarted scene starts from
+    void reset_blackboard(Blackboard &blackboard);
+
+    // seeds the rng and puts the camera back at the start
+    void begin_scene(Blackboard &blackboard);
+
+    // snapshots the backgrounds, panda, HUD, overlay and the story timer, for init_scene() to call
+    // once they're built and before the level is
+    void capture_shell(const std::vector<uint32_t> &backgrounds, uint32_t timer_entity);
+
+    // copies the shell back after cleanup(): panda_entity and fade_overlay_entity name the copies,
+    // the backgrounds' copies are appended and timer_entity is set in story modes. The panda's
+    // health and the HUD text that isn't the score are brought up to date.
+    void restore_shell(Blackboard &blackboard, std::vector<uint32_t> &backgrounds, uint32_t &timer_entity,
+                       int high_score);
+
 };
 
 
@@ -16,12 +16,12 @@ HorizontalScene::HorizontalScene(Blackboard &blackboard, SceneManager &scene_man
         level_system(),
         sprite_transform_system(),
         background_transform_system(JUNGLE_TYPE),
-        physics_system(),
+        physics_system(level_system.pool()),
         player_movement_system(JUNGLE_TYPE),
-        enemy_system(),
+        enemy_system(level_system.pool()),
         player_animation_system(JUNGLE_TYPE),
         panda_dmg_system(),
-        falling_platform_system(),
+        falling_platform_system(timer_system),
         enemy_animation_system(),
         health_bar_transform_system(),
         text_transform_system(),
@@ -34,10 +34,31 @@ HorizontalScene::HorizontalScene(Blackboard &blackboard, SceneManager &scene_man
         powerup_system()
 {
     high_score_ = 0;
+    schedule_systems();
     init_scene(blackboard);
     gl_has_errors("horizontal_scene");
 }
 
+void HorizontalScene::schedule_systems() {
+    scheduler_.add_system("level", level_system);
+    scheduler_.add_system("physics", physics_system);
+    scheduler_.add_step("enemy", [this](Blackboard &blackboard, entt::DefaultRegistry &registry) {
+        enemy_system.update(blackboard, registry, JUNGLE_TYPE);
+    });
+    scheduler_.add_system("sprite_transform", sprite_transform_system, sprite_transform_system.access());
+    scheduler_.add_system("health_bar_transform", health_bar_transform_system,
+                          health_bar_transform_system.access());
+    scheduler_.add_system("player_animation", player_animation_system, player_animation_system.access());
+    scheduler_.add_system("text_transform", text_transform_system, text_transform_system.access());
+    scheduler_.add_system("label", label_system, label_system.access());
+    scheduler_.add_system("timer", timer_system, timer_system.access());
+    scheduler_.add_system("falling_platform", falling_platform_system);
+    scheduler_.add_system("enemy_animation", enemy_animation_system, enemy_animation_system.access());
+    scheduler_.add_system("transition", transition_system);
+    scheduler_.add_system("powerup", powerup_system);
+    scheduler_.add_system("hud_transform", hud_transform_system, hud_transform_system.access()); // Must run last
+}
+
 void HorizontalScene::update(Blackboard &blackboard) {
     auto &panda = registry_.get<Panda>(panda_entity);
     auto &interactable = registry_.get<Interactable>(panda_entity);
@@ -45,6 +66,12 @@ void HorizontalScene::update(Blackboard &blackboard) {
 
     if (blackboard.camera.transition_ready) {
         if (fadeOverlay.alpha() < 0.9f) {
+            // the next scene gets its level and textures ready while this one fades out
+            if (mode_ == STORY_EASY) {
+                prepare_scene(STORY_EASY_SKY_SCENE_ID);
+            } else if (mode_ == STORY_HARD) {
+                prepare_scene(STORY_HARD_SKY_SCENE_ID);
+            }
             fade_overlay_system.update(blackboard, registry_);
         } else {
             go_to_next_scene(blackboard);
@@ -90,20 +117,7 @@ void HorizontalScene::update(Blackboard &blackboard) {
 
         update_panda(blackboard);
 
-        level_system.update(blackboard, registry_);
-        physics_system.update(blackboard, registry_);
-        enemy_system.update(blackboard, registry_, JUNGLE_TYPE);
-        sprite_transform_system.update(blackboard, registry_);
-        health_bar_transform_system.update(blackboard, registry_);
-        player_animation_system.update(blackboard, registry_);
-        text_transform_system.update(blackboard, registry_);
-        label_system.update(blackboard, registry_);
-        timer_system.update(blackboard, registry_);
-        falling_platform_system.update(blackboard, registry_);
-        enemy_animation_system.update(blackboard, registry_);
-        transition_system.update(blackboard, registry_);
-        powerup_system.update(blackboard, registry_);
-        hud_transform_system.update(blackboard, registry_);// Must run last
+        scheduler_.run(blackboard, registry_);
         high_score_ = std::max<int>(high_score_, (int) blackboard.score);
 
         if (!blackboard.camera.transition_ready) {
@@ -125,11 +139,11 @@ void HorizontalScene::update_panda(Blackboard &blackboard) {
     if (transform.x + panda_collidable.width < cam_position.x - cam_size.x / 2 ||
         transform.y - panda_collidable.height > cam_position.y + cam_size.y / 2 || panda.dead) {
         if (mode_ == ENDLESS) {
-            reset_scene(blackboard);
+            respawn(blackboard);
         } else if (blackboard.story_lives > 1) {
             blackboard.story_lives -= 1;
             blackboard.story_health = MAX_HEALTH;
-            reset_scene(blackboard);
+            respawn(blackboard);
         } else {
             blackboard.story_lives -= 1;
             blackboard.camera.set_position(0, 0);
@@ -162,16 +176,39 @@ void HorizontalScene::render(Blackboard &blackboard) {
     render_system.update(blackboard, registry_);
 }
 
+void HorizontalScene::prepare(SceneMode mode, Blackboard &blackboard) {
+    level_system.prepare(mode);
+}
+
 void HorizontalScene::reset_scene(Blackboard &blackboard) {
+    uint64_t start = SDL_GetPerformanceCounter();
     cleanup();
-    blackboard.camera.in_transition = false;
-    blackboard.camera.transition_ready = false;
-    blackboard.score = 0;
-    blackboard.soundManager.changeBackgroundMusic(blackboard.soundManager.currentStage);
+    reset_blackboard(blackboard);
     init_scene(blackboard);
+    printf("jungle reset: rebuilt in %.2fms\n",
+           (SDL_GetPerformanceCounter() - start) * 1000.f / SDL_GetPerformanceFrequency());
+}
+
+void HorizontalScene::respawn(Blackboard &blackboard) {
+    if (shell_.empty()) {
+        reset_scene(blackboard);
+        return;
+    }
+    uint64_t start = SDL_GetPerformanceCounter();
+    cleanup();
+    reset_blackboard(blackboard);
+    begin_scene(blackboard);
+
+    restore_shell(blackboard, bg_entities, timer_entity, high_score_);
+
+    blackboard.post_process_chain.clear();
+    level_system.init(mode_, registry_);
+    printf("jungle reset: restored %zu entities (%zu bytes) in %.2fms\n", shell_.size(), shell_.bytes(),
+           (SDL_GetPerformanceCounter() - start) * 1000.f / SDL_GetPerformanceFrequency());
 }
 
 void HorizontalScene::cleanup() {
+    scheduler_.print_report("jungle");
     level_system.destroy_entities(registry_);
     for (uint32_t e: bg_entities) {
         registry_.destroy(e);
@@ -200,10 +237,7 @@ void HorizontalScene::go_to_next_scene(Blackboard &blackboard) {
 }
 
 void HorizontalScene::init_scene(Blackboard &blackboard) {
-    blackboard.randNumGenerator.init(0);
-    blackboard.camera.set_position(CAMERA_START_X, CAMERA_START_Y);
-    blackboard.camera.compose();
-    blackboard.time_multiplier = DEFAULT_SPEED_MULTIPLIER;
+    begin_scene(blackboard);
     create_background(blackboard);
     create_panda(blackboard);
     if (mode_ == ENDLESS) {
@@ -220,7 +254,8 @@ void HorizontalScene::init_scene(Blackboard &blackboard) {
     create_fade_overlay(blackboard);
     auto &fadeOverlay = registry_.get<FadeOverlay>(fade_overlay_entity);
     fadeOverlay.set_alpha(1.0);
-    blackboard.post_process_shader = std::make_unique<Shader>(blackboard.shader_manager.get_shader("sprite"));
+    capture_shell(bg_entities, timer_entity);
+    blackboard.post_process_chain.clear();
     level_system.init(mode_, registry_);
 }
 
@@ -32,6 +32,7 @@
 #include "../systems/player_animation_system.h"
 #include "../systems/enemy_animation_system.h"
 #include "game_scene.h"
+#include "../systems/system_scheduler.h"
 
 class HorizontalScene: public GameScene {
 private:
@@ -40,7 +41,7 @@ private:
     int high_score_;
 
     uint32_t timer_entity;
-    const std::string END_TIMER_LABEL = "end";
+    const TimerLabel END_TIMER_LABEL = Timer::label("end");
     const float END_TIMER_LENGTH = 40;
 
     std::vector<uint32_t> bg_entities;
@@ -65,9 +66,12 @@ private:
     LabelSystem label_system;
     RenderSystem render_system;
     PowerupSystem powerup_system;
+    SystemScheduler scheduler_;
 
+    void schedule_systems();
     void create_background(Blackboard &blackboard);
     void init_scene(Blackboard &blackboard);
+    void respawn(Blackboard &blackboard);
     void update_panda(Blackboard& blackboard);
     void update_camera(Blackboard& blackboard);
     void check_end_timer();
@@ -83,6 +87,9 @@ public:
     void set_high_score(int value);
 
     int get_high_score();
+
+    void prepare(SceneMode mode, Blackboard& blackboard) override;
+
     void reset_scene(Blackboard& blackboard) override;
 
     static constexpr float CAMERA_SPEED = 400.f;
@@ -45,6 +45,7 @@ void MainMenuScene::update(Blackboard& blackboard) {
     if (selected_button_ < 0) {
         selected_button_ = 0;
     }
+    int was_selected = selected_button_;
 
     if (blackboard.input_manager.key_just_pressed(SDL_SCANCODE_UP)) {
         if (selected_button_ == 0) {
@@ -58,6 +59,11 @@ void MainMenuScene::update(Blackboard& blackboard) {
         selected_button_ ++;
         selected_button_ %= count;
     }
+    if (selected_button_ != was_selected) {
+        selected_time_ = 0.f;
+    } else {
+        selected_time_ += blackboard.delta_time;
+    }
 
     for (auto i = 0; i < count; i++) {
         if (i == selected_button_) {
@@ -91,6 +97,11 @@ void MainMenuScene::update(Blackboard& blackboard) {
         if (blackboard.input_manager.key_just_pressed(SDL_SCANCODE_ESCAPE)) {
             blackboard.input_manager.signal_exit();
         }
+        // a selection the player settles on starts loading, so entering it doesn't stall on
+        // textures or the first chunk; confirming before then just loads it on entry
+        if (selected_time_ >= PREPARE_DELAY) {
+            prepare_scene(button_targets_[selected_button_]);
+        }
         if (blackboard.input_manager.key_just_pressed(SDL_SCANCODE_RETURN)) {
             change_scene(button_targets_[selected_button_], true);
         }
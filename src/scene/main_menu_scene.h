@@ -24,6 +24,7 @@ private:
     std::vector<uint32_t> button_y_positions_;
     std::vector<SceneID> button_targets_;
     int selected_button_ = -1;
+    float selected_time_ = 0.f; // seconds the selection has stayed on selected_button_
     bool pause = false;
 
     const int BUTTON_WIDTH = 625;
@@ -35,6 +36,9 @@ private:
     const float TUTORIAL_Y = 350.f;
     const float TUTORIAL_WIDTH = 110.f;
     const float TUTORIAL_HEIGHT = 100.f;
+    // how long a button stays selected before its scene is prepared, so scrolling past
+    // buttons doesn't build every scene on the way
+    const float PREPARE_DELAY = 0.4f;
 
     PauseMenuTransformSystem pause_menu_transform_system;
     RenderSystem render_system;
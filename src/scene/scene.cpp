@@ -7,13 +7,24 @@
 
 Scene::Scene(SceneManager &scene_manager) :
     scene_manager_(scene_manager),
-    registry_()
+    registry_(),
+    mode_(ENDLESS)
 {}
 
 bool Scene::change_scene(SceneID id, bool reset) {
     return scene_manager_.change_scene(id, reset);
 }
 
+void Scene::prepare_scene(SceneID id) {
+    scene_manager_.prepare_scene(id);
+}
+
+void Scene::prepare(SceneMode mode, Blackboard &blackboard) {}
+
 void Scene::set_mode(SceneMode mode, Blackboard &blackboard) {
     mode_ = mode;
 }
+
+void Scene::flush_commands(Blackboard &blackboard) {
+    blackboard.commands.apply(registry_);
+}
@@ -23,11 +23,14 @@ private:
 
 protected:
     entt::DefaultRegistry registry_;
-    SceneMode mode_;
+    SceneMode mode_; // ENDLESS until set_mode(), scenes are built before they know their mode
 
 public:
     Scene(SceneManager& scene_manager);
 
+    // scenes built from a SceneManager factory are destroyed through this base
+    virtual ~Scene() = default;
+
     // the "=0" denotes pure virtual functions
     // which establish the Scene class as abstract
 
@@ -41,7 +44,17 @@ public:
 
     virtual void reset_scene(Blackboard& blackboard) = 0;
 
+    // starts the CPU-side work of the next reset_scene off the main thread, called while the
+    // previous scene is still playing; mode is the one the scene will be entered with
+    virtual void prepare(SceneMode mode, Blackboard& blackboard);
+
+    // applies the structural changes recorded during update() to this scene's registry
+    void flush_commands(Blackboard& blackboard);
+
 protected:
     // wraps SceneManager::change_scene()
     bool change_scene(SceneID id, bool reset = false);
+
+    // wraps SceneManager::prepare_scene()
+    void prepare_scene(SceneID id);
 };
\ No newline at end of file
@@ -2,10 +2,31 @@
 // Created by alex on 20/01/19.
 //
 
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#ifdef __linux__
+#include <unistd.h>
+#endif
 #include <entt/entity/registry.hpp>
 #include "util/constants.h"
 #include "scene_manager.h"
 
+// resident set size of the whole process, 0 where /proc isn't available
+static size_t process_resident_bytes() {
+    size_t bytes = 0;
+#ifdef __linux__
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (statm != nullptr) {
+        unsigned long size, resident;
+        if (fscanf(statm, "%lu %lu", &size, &resident) == 2) {
+            bytes = resident * (size_t) sysconf(_SC_PAGESIZE);
+        }
+        fclose(statm);
+    }
+#endif
+    return bytes;
+}
 
 SceneManager::SceneManager(Blackboard& blackboard) :
     scenes_(),
@@ -20,9 +41,85 @@ bool SceneManager::add_scene(SceneID id, Scene *scene) {
         return false;
     }
     else {
-        scenes_.insert(std::pair<SceneID, Scene*>(id, scene));
+        slots_.emplace_back(new SceneSlot{nullptr, nullptr, nullptr, scene});
+        scenes_.insert(std::pair<SceneID, SceneSlot*>(id, slots_.back().get()));
+        return true;
+    }
+}
+
+int SceneManager::add_scene_factory(SceneFactory factory, SceneTeardown teardown) {
+    slots_.emplace_back(new SceneSlot{std::move(factory), std::move(teardown), nullptr, nullptr});
+    return (int) slots_.size() - 1;
+}
+
+bool SceneManager::add_scene(SceneID id, int factory, SceneMode mode) {
+    if (scenes_.count(id) > 0 || scene_modes_.count(id) > 0 || factory < 0 || factory >= (int) slots_.size()) {
+        return false;
+    }
+    else {
+        scenes_[id] = slots_[factory].get();
+        scene_modes_[id] = mode;
+        return true;
+    }
+}
+
+void SceneManager::set_lifetime(SceneLifetime lifetime) {
+    lifetime_ = lifetime;
+}
+
+Scene* SceneManager::build(SceneSlot& slot) {
+    if (slot.scene == nullptr) {
+        uint64_t start = SDL_GetPerformanceCounter();
+        slot.owned = slot.factory();
+        slot.scene = slot.owned.get();
+        float ms = (SDL_GetPerformanceCounter() - start) * 1000.f / SDL_GetPerformanceFrequency();
+        builds_++;
+        build_ms_ += ms;
+        printf("scenes: built in %.1fms\n", ms);
+    }
+    return slot.scene;
+}
+
+void SceneManager::leave(SceneSlot* slot) {
+    if (lifetime_ == TEAR_DOWN_LEFT_SCENES && slot->factory && slot->owned &&
+        std::find(leaving_.begin(), leaving_.end(), slot) == leaving_.end()) {
+        leaving_.push_back(slot);
+    }
+}
+
+void SceneManager::tear_down(SceneSlot& slot) {
+    if (!slot.owned) {
+        return;
+    }
+    if (slot.teardown) {
+        slot.teardown(*slot.owned);
+    }
+    slot.owned.reset();
+    slot.scene = nullptr;
+}
+
+void SceneManager::teardown_all() {
+    for (auto& slot : slots_) {
+        tear_down(*slot);
+    }
+    leaving_.clear();
+}
+
+bool SceneManager::only_live_scenes_built() const {
+    if (lifetime_ != TEAR_DOWN_LEFT_SCENES) {
         return true;
     }
+    for (auto& slot : slots_) {
+        if (!slot->factory || !slot->owned) {
+            continue;
+        }
+        bool current = current_scene_set_ && scenes_.at(current_scene_) == slot.get();
+        bool prepared = prepared_scene_set_ && scenes_.at(prepared_scene_) == slot.get();
+        if (!current && !prepared) {
+            return false;
+        }
+    }
+    return true;
 }
 
 bool SceneManager::change_scene(SceneID id, bool reset) {
@@ -30,15 +127,51 @@ bool SceneManager::change_scene(SceneID id, bool reset) {
         return false;
     }
     else {
+        // acquire before releasing so textures both scenes share stay resident
+        auto& textures = blackboard.texture_manager;
+        bool prepared = prepared_scene_set_ && prepared_scene_ == id;
+        if (texture_manifests_.count(id) > 0) {
+            auto& manifest = texture_manifests_[id];
+            if (!prepared) {
+                textures.acquire(manifest);
+            }
+            for (auto& name : manifest) {
+                textures.wait_for(name.c_str());
+            }
+        }
+        if (prepared_scene_set_ && !prepared && texture_manifests_.count(prepared_scene_) > 0) {
+            textures.release(texture_manifests_[prepared_scene_]);
+        }
+        // a scene prepared and then skipped is left like the current one
+        SceneSlot* unprepared = prepared_scene_set_ ? scenes_[prepared_scene_] : nullptr;
+        prepared_scene_set_ = false;
+        if (current_scene_set_ && texture_manifests_.count(current_scene_) > 0) {
+            textures.release(texture_manifests_[current_scene_]);
+        }
+        SceneSlot* left = current_scene_set_ ? scenes_[current_scene_] : nullptr;
+        size_t evicted = textures.evict_unreferenced();
+        if (evicted > 0) {
+            printf("textures: evicted %.1fMB leaving scene %d\n", evicted / (1024.f * 1024.f), current_scene_);
+        }
+
         current_scene_ = id;
         current_scene_set_ = true;
+        SceneSlot* entered = scenes_[id];
+        Scene* scene = build(*entered);
+        for (SceneSlot* slot : {left, unprepared}) {
+            if (slot != nullptr && slot != entered) {
+                leave(slot);
+            }
+        }
+        print_texture_report();
+        print_scene_report();
         blackboard.soundManager.changeBackgroundMusic(id);
 
         if (scene_modes_.count(id) > 0) {
-            scenes_[id]->set_mode(scene_modes_[id], blackboard);
+            scene->set_mode(scene_modes_[id], blackboard);
         }
         if (reset) {
-            scenes_[id]->reset_scene(blackboard);
+            scene->reset_scene(blackboard);
         }
 
         return true;
@@ -46,16 +179,53 @@ bool SceneManager::change_scene(SceneID id, bool reset) {
 }
 
 
+void SceneManager::prepare_scene(SceneID id) {
+    if (scenes_.count(id) == 0 || (prepared_scene_set_ && prepared_scene_ == id) ||
+        (current_scene_set_ && current_scene_ == id)) {
+        return;
+    }
+
+    auto& textures = blackboard.texture_manager;
+    if (texture_manifests_.count(id) > 0) {
+        textures.acquire(texture_manifests_[id]);
+    }
+    if (prepared_scene_set_ && texture_manifests_.count(prepared_scene_) > 0) {
+        textures.release(texture_manifests_[prepared_scene_]);
+    }
+    SceneSlot* unprepared = prepared_scene_set_ ? scenes_[prepared_scene_] : nullptr;
+    prepared_scene_ = id;
+    prepared_scene_set_ = true;
+    if (unprepared != nullptr && unprepared != scenes_[id]) {
+        leave(unprepared);
+    }
+
+    SceneMode mode = scene_modes_.count(id) > 0 ? scene_modes_[id] : ENDLESS;
+    build(*scenes_[id])->prepare(mode, blackboard);
+}
+
 void SceneManager::update(Blackboard& blackboard) {
     if (current_scene_set_) {
-        scenes_[current_scene_]->update(blackboard);
+        // the scene may change scenes during its update, its commands still belong to its registry
+        Scene* scene = scenes_[current_scene_]->scene;
+        scene->update(blackboard);
+        scene->flush_commands(blackboard);
     }
 
+    // nothing runs in a left scene any more, unless it was entered or prepared again meanwhile
+    for (SceneSlot* slot : leaving_) {
+        if ((current_scene_set_ && scenes_[current_scene_] == slot) ||
+            (prepared_scene_set_ && scenes_[prepared_scene_] == slot)) {
+            continue;
+        }
+        tear_down(*slot);
+    }
+    leaving_.clear();
+    assert(only_live_scenes_built());
 }
 
 void SceneManager::render(Blackboard& blackboard) {
     if (current_scene_set_) {
-        scenes_[current_scene_]->render(blackboard);
+        scenes_[current_scene_]->scene->render(blackboard);
     }
 }
 
@@ -64,8 +234,36 @@ bool SceneManager::add_scene(SceneID id, Scene* scene, SceneMode mode) {
         return false;
     }
     else {
-        scenes_[id] = scene;
+        slots_.emplace_back(new SceneSlot{nullptr, nullptr, nullptr, scene});
+        scenes_[id] = slots_.back().get();
         scene_modes_[id] = mode;
         return true;
     }
 }
+
+void SceneManager::set_texture_manifest(SceneID id, std::vector<std::string> textures) {
+    texture_manifests_[id] = std::move(textures);
+}
+
+void SceneManager::print_texture_report() {
+    auto& textures = blackboard.texture_manager;
+    printf("textures: %.1fMB resident, current scene %d\n",
+           textures.resident_bytes() / (1024.f * 1024.f), current_scene_);
+    for (auto& manifest : texture_manifests_) {
+        printf("  scene %d: %.1fMB resident\n", manifest.first,
+               textures.resident_bytes(manifest.second) / (1024.f * 1024.f));
+    }
+}
+
+void SceneManager::print_scene_report() {
+    size_t built = 0;
+    size_t factories = 0;
+    for (auto& slot : slots_) {
+        if (slot->factory) {
+            factories++;
+            built += slot->owned ? 1 : 0;
+        }
+    }
+    printf("scenes: %zu of %zu built, %zu builds taking %.1fms, %.1fMB process resident\n",
+           built, factories, builds_, build_ms_, process_resident_bytes() / (1024.f * 1024.f));
+}
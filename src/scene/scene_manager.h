@@ -4,7 +4,11 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <string>
 #include <unordered_map>
+#include <vector>
 #include <SDL.h>
 #include <SDL_mixer.h>
 #include <sstream>
@@ -12,13 +16,54 @@
 #include "../util/blackboard.h"
 #include "scene_mode.h"
 
+// what happens to a scene built from a factory once the player leaves it
+enum SceneLifetime {
+    KEEP_BUILT_SCENES, // built on first entry and kept until exit, re-entering is free
+    TEAR_DOWN_LEFT_SCENES // destroyed after the frame it's left in, re-entering builds it again
+};
 
 class SceneManager {
+public:
+    using SceneFactory = std::function<std::unique_ptr<Scene>()>;
+    // called just before a built scene is destroyed, to carry state like high scores out of it
+    using SceneTeardown = std::function<void(Scene&)>;
+
 private:
-    std::unordered_map<SceneID, Scene*> scenes_;
+    // one scene object, possibly registered under several ids with different modes
+    struct SceneSlot {
+        SceneFactory factory; // empty for scenes managed elsewhere
+        SceneTeardown teardown;
+        std::unique_ptr<Scene> owned;
+        Scene* scene; // owned.get(), or the scene passed to add_scene(), null until built
+    };
+
+    std::vector<std::unique_ptr<SceneSlot>> slots_;
+    std::unordered_map<SceneID, SceneSlot*> scenes_;
     std::unordered_map<SceneID, SceneMode> scene_modes_;
+    // textures each scene needs resident while it's active
+    std::unordered_map<SceneID, std::vector<std::string>> texture_manifests_;
     Blackboard& blackboard;
     bool current_scene_set_ = false;
+    // the scene prepare_scene() got ready, it holds its manifest until it's entered or replaced
+    SceneID prepared_scene_;
+    bool prepared_scene_set_ = false;
+    SceneLifetime lifetime_ = KEEP_BUILT_SCENES;
+    // slots left or unprepared since the last update, torn down once nothing is running in them
+    std::vector<SceneSlot*> leaving_;
+    size_t builds_ = 0;
+    float build_ms_ = 0;
+
+    // constructs the slot's scene if it hasn't been yet
+    Scene* build(SceneSlot& slot);
+
+    // queues a slot for teardown under TEAR_DOWN_LEFT_SCENES
+    void leave(SceneSlot* slot);
+
+    void tear_down(SceneSlot& slot);
+
+    // under TEAR_DOWN_LEFT_SCENES, whether the scenes built from factories are only the current
+    // and the prepared one, which holds once update() has torn down the scenes left meanwhile
+    bool only_live_scenes_built() const;
 
 public:
     SceneManager(Blackboard& blackboard);
@@ -31,12 +76,39 @@ public:
 
     bool add_scene(SceneID id, Scene* scene, SceneMode mode);
 
+    // registers a scene that is constructed the first time one of its ids is entered or prepared,
+    // returns the handle to pass to add_scene() for every id that shares the scene
+    int add_scene_factory(SceneFactory factory, SceneTeardown teardown = nullptr);
+
+    // fails and returns false if another scene exists with the given ID or the handle is unknown
+    bool add_scene(SceneID id, int factory, SceneMode mode);
+
+    void set_lifetime(SceneLifetime lifetime);
+
+    // destroys every scene built from a factory, running their teardowns, e.g. before saving at exit
+    void teardown_all();
+
+    // prints how many scenes are built, the time spent building them and the process resident memory
+    void print_scene_report();
+
+    // sets the registered textures to load when the scene is entered and release when it's left
+    void set_texture_manifest(SceneID id, std::vector<std::string> textures);
+
+    // prints the resident texture bytes of every scene with a manifest
+    void print_texture_report();
+
     // attempts to change current scene to one with given id
     // if called during update(), will switch scenes after current update()
+    // loads the new scene's texture manifest, then evicts textures no scene references
     // fails and returns false if no such scene exists
     // returns true otherwise
     bool change_scene(SceneID id, bool reset = false);
 
+    // gets a scene ready ahead of change_scene(id), e.g. while the current one fades out:
+    // its textures start loading and it prepares what it can off the main thread.
+    // Only one scene is prepared at a time, asking again for the same one does nothing
+    void prepare_scene(SceneID id);
+
     // attempts to update the current scene, if one exists
     void update(Blackboard& blackboard);
 
@@ -22,7 +22,7 @@
 #include "story_end_scene.h"
 #include "util/constants.h"
 
-std::string const StoryEndScene::END_SCENE_END_LABEL = "end_scene";
+TimerLabel const StoryEndScene::END_SCENE_END_LABEL = Timer::label("end_scene");
 
 StoryEndScene::StoryEndScene(Blackboard &blackboard, SceneManager &scene_manager) :
         GameScene(scene_manager),
@@ -29,7 +29,7 @@ private:
     const float END_SCENE_END = 15.f;
     const float SKIP_POS_X = 1800.f;
     const float SKIP_POS_Y = 350.f;
-    const std::string SKIP_SCENE_LABEL;
+    const TimerLabel SKIP_SCENE_LABEL = Timer::label("skip");
     const float SKIP_SCENE = 20.f;
     const float SKIP_SPEED = 250.f;
 
@@ -62,7 +62,7 @@ public:
     StoryEndScene(Blackboard &blackboard,
                          SceneManager &scene_manager);
 
-    static const std::string END_SCENE_END_LABEL;
+    static const TimerLabel END_SCENE_END_LABEL;
 
     virtual void update(Blackboard& blackboard) override;
     virtual void render(Blackboard& blackboard) override;
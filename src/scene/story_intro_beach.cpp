@@ -18,7 +18,7 @@
 #include "story_intro_beach.h"
 #include "util/constants.h"
 
-std::string const StoryIntroBeachScene::BEACH_SCENE_END_LABEL = "end_scene";
+TimerLabel const StoryIntroBeachScene::BEACH_SCENE_END_LABEL = Timer::label("end_scene");
 
 StoryIntroBeachScene::StoryIntroBeachScene(Blackboard &blackboard, SceneManager &scene_manager) :
         GameScene(scene_manager),
@@ -69,6 +69,11 @@ void StoryIntroBeachScene::update(Blackboard &blackboard) {
         background_transform_system.update(blackboard, registry_);
         if (endScene || (!endScene && fadeOverlay.alpha() > 0.f)) {
             fade_overlay_system.update(blackboard, registry_);
+            // only while the overlay fades out, the fade in at the start would load the next
+            // scene's textures for the whole intro
+            if (!fadeOverlay.fadeIn() && fadeOverlay.alpha() > 0.f) {
+                prepare_scene(STORY_JUNGLE_INTRO_SCENE_ID);
+            }
         }
     } else {
         pause_menu_transform_system.update(blackboard, registry_);
@@ -33,7 +33,7 @@ private:
     const float BEACH_SCENE_END = 32.f;
     const float SKIP_POS_X = 1800.f;
     const float SKIP_POS_Y = 350.f;
-    const std::string SKIP_SCENE_LABEL;
+    const TimerLabel SKIP_SCENE_LABEL = Timer::label("skip");
     const float SKIP_SCENE = 9.f;
     const float SKIP_SPEED = 250.f;
 
@@ -71,7 +71,7 @@ public:
     StoryIntroBeachScene(Blackboard &blackboard,
                     SceneManager &scene_manager);
 
-    static const std::string BEACH_SCENE_END_LABEL;
+    static const TimerLabel BEACH_SCENE_END_LABEL;
 
     virtual void update(Blackboard& blackboard) override;
     virtual void render(Blackboard& blackboard) override;
@@ -19,7 +19,7 @@
 #include "story_intro_jungle.h"
 #include "util/constants.h"
 
-std::string const StoryIntroJungleScene::JUNGLE_SCENE_END_LABEL = "end_scene";
+TimerLabel const StoryIntroJungleScene::JUNGLE_SCENE_END_LABEL = Timer::label("end_scene");
 
 StoryIntroJungleScene::StoryIntroJungleScene(Blackboard &blackboard, SceneManager &scene_manager) :
         GameScene(scene_manager),
@@ -67,6 +67,11 @@ void StoryIntroJungleScene::update(Blackboard &blackboard) {
         physics_system.update(blackboard, registry_);
         if (endScene || (!endScene && fadeOverlay.alpha() > 0.f)) {
             fade_overlay_system.update(blackboard, registry_);
+            // only while the overlay fades out, the fade in at the start would load the next
+            // scene's textures for the whole intro
+            if (!fadeOverlay.fadeIn() && fadeOverlay.alpha() > 0.f) {
+                prepare_scene(STORY_EASY_JUNGLE_SCENE_ID);
+            }
         }
         if (story_animation_system.pandaGetsVape == 1) {
             create_strobe_effect(blackboard);
@@ -235,23 +240,19 @@ void StoryIntroJungleScene::create_vape(Blackboard &blackboard) {
 }
 
 void StoryIntroJungleScene::create_strobe_effect(Blackboard &blackboard) {
-    scene_timer.save_watch("STROBE", STROBE); // 5 second timer for effect
-    blackboard.post_process_shader = std::make_unique<Shader>(
-            blackboard.shader_manager.get_shader("strobe"));
+    scene_timer.save_watch(STROBE_LABEL, STROBE); // 5 second timer for effect
+    blackboard.post_process_chain.add_pass("STROBE", blackboard.shader_manager.get_shader("strobe"));
 }
 
 void StoryIntroJungleScene::update_strobe_effect(Blackboard &blackboard) {
-    if (scene_timer.exists("STROBE")) {
-        float val = ((3*(scene_timer.get_target_time("STROBE") - scene_timer.get_curr_time()) /
+    if (scene_timer.exists(STROBE_LABEL)) {
+        float val = ((3*(scene_timer.get_target_time(STROBE_LABEL) - scene_timer.get_curr_time()) /
                 STROBE)); // Ratio of time done (Ranges from [1...0])
-        blackboard.post_process_shader->bind();
-        blackboard.post_process_shader->set_uniform_float("timeElapsed", val);
-        blackboard.post_process_shader->unbind();
+        blackboard.post_process_chain.set_uniform_float("STROBE", "timeElapsed", val);
         // Setup new timeElapsed Uniform
-        if (scene_timer.is_done("STROBE")) {
-            blackboard.post_process_shader = std::make_unique<Shader>(
-                    blackboard.shader_manager.get_shader("sprite"));
-            scene_timer.remove("STROBE");
+        if (scene_timer.is_done(STROBE_LABEL)) {
+            blackboard.post_process_chain.remove_pass("STROBE");
+            scene_timer.remove(STROBE_LABEL);
         }
     }
 }
@@ -259,21 +260,17 @@ void StoryIntroJungleScene::update_strobe_effect(Blackboard &blackboard) {
 void StoryIntroJungleScene::create_vape_effect(Blackboard &blackboard) {
     blackboard.time_multiplier *= 0.6f;
     scene_timer.save_watch(VAPE_TIMER_LABEL, VAPE_TIMER);
-    blackboard.post_process_shader = std::make_unique<Shader>(
-            blackboard.shader_manager.get_shader("shift"));
+    blackboard.post_process_chain.add_pass(VAPE_PASS, blackboard.shader_manager.get_shader("shift"));
 }
 
 void StoryIntroJungleScene::update_vape_effect(Blackboard &blackboard) {
     if (scene_timer.exists(VAPE_TIMER_LABEL)) {
         float val = (((scene_timer.get_target_time(VAPE_TIMER_LABEL) - scene_timer.get_curr_time()) /
                       VAPE_TIMER));
-        blackboard.post_process_shader->bind();
-        blackboard.post_process_shader->set_uniform_float("timeElapsed", val);
-        blackboard.post_process_shader->unbind();
+        blackboard.post_process_chain.set_uniform_float(VAPE_PASS, "timeElapsed", val);
         blackboard.time_multiplier = fmax(0.5f, 1 - val);
         if (scene_timer.is_done(VAPE_TIMER_LABEL)) {
-            blackboard.post_process_shader = std::make_unique<Shader>(
-                    blackboard.shader_manager.get_shader("sprite"));
+            blackboard.post_process_chain.remove_pass(VAPE_PASS);
             scene_timer.remove(VAPE_TIMER_LABEL);
         }
     }
@@ -28,16 +28,16 @@ private:
     const float KELLY_POS_Y = -150.f;
     const float VAPE_POS_X = 0.f;
     const float VAPE_POS_Y = -1200.f;
-    const std::string SCENE_END_LABEL = "end_scene";
+    const TimerLabel SCENE_END_LABEL = Timer::label("end_scene");
     const float SCENE_END = 38.f;
     const float SKIP_POS_X = 1800.f;
     const float SKIP_POS_Y = 350.f;
-    const std::string SKIP_SCENE_LABEL = "skip";
+    const TimerLabel SKIP_SCENE_LABEL = Timer::label("skip");
     const float SKIP_SCENE = 9.f;
     const float SKIP_SPEED = 250.f;
-    const std::string STROBE_LABEL = "STROBE";
+    const TimerLabel STROBE_LABEL = Timer::label("STROBE");
     const float STROBE = 2.f;
-    const std::string VAPE_TIMER_LABEL = "VAPE";
+    const TimerLabel VAPE_TIMER_LABEL = Timer::label("VAPE");
     const float VAPE_TIMER = 2.f;
 
 
@@ -72,7 +72,7 @@ public:
     StoryIntroJungleScene(Blackboard &blackboard,
                          SceneManager &scene_manager);
 
-    static const std::string JUNGLE_SCENE_END_LABEL;
+    static const TimerLabel JUNGLE_SCENE_END_LABEL;
 
 
     virtual void update(Blackboard& blackboard) override;
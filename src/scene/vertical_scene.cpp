@@ -10,13 +10,13 @@ VerticalScene::VerticalScene(Blackboard &blackboard, SceneManager &scene_manager
         GameScene(scene_manager),
         level_system(),
         sprite_transform_system(),
-        physics_system(),
+        physics_system(level_system.pool()),
         player_movement_system(SKY_TYPE),
         player_animation_system(SKY_TYPE),
         panda_dmg_system(),
-        falling_platform_system(),
+        falling_platform_system(timer_system),
         background_transform_system(SKY_TYPE),
-        enemy_system(),
+        enemy_system(level_system.pool()),
         enemy_animation_system(),
         text_transform_system(),
         score_system(SKY_TYPE),
@@ -28,16 +28,36 @@ VerticalScene::VerticalScene(Blackboard &blackboard, SceneManager &scene_manager
         powerup_system()
 {
     high_score_ = 0;
+    schedule_systems();
     init_scene(blackboard);
     gl_has_errors("vertical_scene");
 }
 
+void VerticalScene::schedule_systems() {
+    scheduler_.add_system("background_transform", background_transform_system,
+                          background_transform_system.access());
+    scheduler_.add_system("level", level_system);
+    scheduler_.add_system("physics", physics_system);
+    scheduler_.add_step("enemy", [this](Blackboard &blackboard, entt::DefaultRegistry &registry) {
+        enemy_system.update(blackboard, registry, SKY_TYPE);
+    });
+    scheduler_.add_system("sprite_transform", sprite_transform_system, sprite_transform_system.access());
+    scheduler_.add_system("health_bar_transform", health_bar_transform_system,
+                          health_bar_transform_system.access());
+    scheduler_.add_system("label", label_system, label_system.access());
+    scheduler_.add_system("text_transform", text_transform_system, text_transform_system.access());
+    scheduler_.add_system("player_animation", player_animation_system, player_animation_system.access());
+    scheduler_.add_system("enemy_animation", enemy_animation_system, enemy_animation_system.access());
+    scheduler_.add_system("timer", timer_system, timer_system.access());
+    scheduler_.add_system("falling_platform", falling_platform_system);
+    scheduler_.add_system("transition", transition_system);
+    scheduler_.add_system("powerup", powerup_system);
+    scheduler_.add_system("hud_transform", hud_transform_system, hud_transform_system.access()); // should run last
+}
+
 
 void VerticalScene::init_scene(Blackboard &blackboard) {
-    blackboard.randNumGenerator.init(0);
-    blackboard.camera.set_position(CAMERA_START_X, CAMERA_START_Y);
-    blackboard.camera.compose();
-    blackboard.time_multiplier = DEFAULT_SPEED_MULTIPLIER;
+    begin_scene(blackboard);
     create_background(blackboard);
     create_panda(blackboard);
     if (mode_ == ENDLESS) {
@@ -54,8 +74,9 @@ void VerticalScene::init_scene(Blackboard &blackboard) {
     create_fade_overlay(blackboard);
     auto &fadeOverlay = registry_.get<FadeOverlay>(fade_overlay_entity);
     fadeOverlay.set_alpha(1.0);
+    capture_shell(bg_entities, timer_entity);
     level_system.init(mode_, registry_);
-    blackboard.post_process_shader = std::make_unique<Shader>(blackboard.shader_manager.get_shader("sprite"));
+    blackboard.post_process_chain.clear();
 }
 
 void VerticalScene::update(Blackboard &blackboard) {
@@ -67,6 +88,12 @@ void VerticalScene::update(Blackboard &blackboard) {
 
     if (blackboard.camera.transition_ready) {
         if (fadeOverlay.alpha() < 0.9f) {
+            // the next scene gets its level and textures ready while this one fades out
+            if (mode_ == STORY_EASY) {
+                prepare_scene(BOSS_SCENE_ID);
+            } else if (mode_ == STORY_HARD) {
+                prepare_scene(DRACULA_BOSS_SCENE_ID);
+            }
             fade_overlay_system.update(blackboard, registry_);
         } else {
             go_to_next_scene(blackboard);
@@ -111,21 +138,7 @@ void VerticalScene::update(Blackboard &blackboard) {
 
         update_panda(blackboard);
 
-        background_transform_system.update(blackboard, registry_);
-        level_system.update(blackboard, registry_);
-        physics_system.update(blackboard, registry_);
-        enemy_system.update(blackboard, registry_, SKY_TYPE);
-        sprite_transform_system.update(blackboard, registry_);
-        health_bar_transform_system.update(blackboard, registry_);
-        label_system.update(blackboard, registry_);
-        text_transform_system.update(blackboard, registry_);
-        player_animation_system.update(blackboard, registry_);
-        enemy_animation_system.update(blackboard, registry_);
-        timer_system.update(blackboard, registry_);
-        falling_platform_system.update(blackboard, registry_);
-        transition_system.update(blackboard, registry_);
-        powerup_system.update(blackboard, registry_);
-        hud_transform_system.update(blackboard, registry_); // should run last
+        scheduler_.run(blackboard, registry_);
         high_score_ = std::max<int>(high_score_, (int)blackboard.score);
 
         if (!blackboard.camera.transition_ready) {
@@ -146,16 +159,39 @@ void VerticalScene::render(Blackboard &blackboard) {
     render_system.update(blackboard, registry_);
 }
 
+void VerticalScene::prepare(SceneMode mode, Blackboard &blackboard) {
+    level_system.prepare(mode);
+}
+
 void VerticalScene::reset_scene(Blackboard &blackboard) {
+    uint64_t start = SDL_GetPerformanceCounter();
     cleanup();
-    blackboard.camera.in_transition = false;
-    blackboard.camera.transition_ready = false;
-    blackboard.score = 0;
-    blackboard.soundManager.changeBackgroundMusic(blackboard.soundManager.currentStage);
+    reset_blackboard(blackboard);
     init_scene(blackboard);
+    printf("sky reset: rebuilt in %.2fms\n",
+           (SDL_GetPerformanceCounter() - start) * 1000.f / SDL_GetPerformanceFrequency());
+}
+
+void VerticalScene::respawn(Blackboard &blackboard) {
+    if (shell_.empty()) {
+        reset_scene(blackboard);
+        return;
+    }
+    uint64_t start = SDL_GetPerformanceCounter();
+    cleanup();
+    reset_blackboard(blackboard);
+    begin_scene(blackboard);
+
+    restore_shell(blackboard, bg_entities, timer_entity, high_score_);
+
+    level_system.init(mode_, registry_);
+    blackboard.post_process_chain.clear();
+    printf("sky reset: restored %zu entities (%zu bytes) in %.2fms\n", shell_.size(), shell_.bytes(),
+           (SDL_GetPerformanceCounter() - start) * 1000.f / SDL_GetPerformanceFrequency());
 }
 
 void VerticalScene::cleanup() {
+    scheduler_.print_report("sky");
     level_system.destroy_entities(registry_);
     for (uint32_t e: bg_entities) {
         registry_.destroy(e);
@@ -256,11 +292,11 @@ void VerticalScene::update_panda(Blackboard &blackboard) {
     if (transform.y - panda_collidable.height / 2 > cam_position.y + cam_size.y / 2 ||
         panda.dead) {
         if (mode_ == ENDLESS) {
-            reset_scene(blackboard);
+            respawn(blackboard);
         } else if (blackboard.story_lives > 1) {
             blackboard.story_lives -= 1;
             blackboard.story_health = MAX_HEALTH;
-            reset_scene(blackboard);
+            respawn(blackboard);
         } else {
             blackboard.story_health = MAX_HEALTH;
             blackboard.story_lives = MAX_LIVES;
@@ -25,6 +25,7 @@
 #include <systems/pause_menu_transform_system.h>
 #include <systems/transition_system.h>
 #include <systems/hud_transform_system.h>
+#include <systems/system_scheduler.h>
 #include <systems/label_system.h>
 #include <systems/render_system.h>
 #include <systems/powerup_system.h>
@@ -32,10 +33,10 @@
 class VerticalScene : public GameScene {
 private:
     std::vector<uint32_t> bg_entities;
+    VerticalLevelSystem level_system; // owns the pool the physics and enemy systems despawn into
     SpriteTransformSystem sprite_transform_system;
     PhysicsSystem physics_system;
     PlayerMovementSystem player_movement_system;
-    VerticalLevelSystem level_system;
     PlayerAnimationSystem player_animation_system;
     EnemyAnimationSystem enemy_animation_system;
     TimerSystem timer_system;
@@ -53,15 +54,18 @@ private:
     LabelSystem label_system;
     RenderSystem render_system;
     PowerupSystem powerup_system;
+    SystemScheduler scheduler_;
 
     bool pause = false;
     int high_score_;
 
     uint32_t timer_entity;
-    const std::string END_TIMER_LABEL = "end";
+    const TimerLabel END_TIMER_LABEL = Timer::label("end");
     const float END_TIMER_LENGTH = 30;
 
+    void schedule_systems();
     void init_scene(Blackboard &blackboard);
+    void respawn(Blackboard &blackboard);
     void check_end_timer();
 public:
 
@@ -87,6 +91,8 @@ public:
 
     void update_panda(Blackboard &blackboard);
 
+    void prepare(SceneMode mode, Blackboard& blackboard) override;
+
     void reset_scene(Blackboard& blackboard) override;
 };
 
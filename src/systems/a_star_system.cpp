@@ -2,6 +2,7 @@
 // Created by Kenneth William on 2019-03-27.
 //
 
+#include <utility>
 #include "a_star_system.h"
 
 
@@ -12,7 +13,7 @@ float manhattanDistance(Location *a, Location *b){
     return abs(a->i - b->i)+abs(a->j - b->j);
 }
 
-bool contains(std::vector<Location*> list, Location* location){
+bool contains(const FrameVector<Location*>& list, Location* location){
     for(int i = 0; i<list.size(); i++){
         if(list[i]==location){
             return true;
@@ -23,6 +24,7 @@ bool contains(std::vector<Location*> list, Location* location){
 
 
 AStarSystem::AStarSystem(Blackboard &blackboard, entt::DefaultRegistry &registry) :
+    level_(Level::load_from_path("dracula_level.csv")),
     grid(),
     data()
 {
@@ -32,49 +34,48 @@ AStarSystem::AStarSystem(Blackboard &blackboard, entt::DefaultRegistry &registry
 
 
 void AStarSystem::createGrid(Blackboard &blackboard, entt::DefaultRegistry &registry) {
-    grid.clear();
-    data.clear();
+    if (!gridPrepared) {
+        prepareGrid();
+    }
+    grid = std::move(preparedGrid);
+    data = std::move(preparedData);
+    preparedGrid.clear();
+    preparedData.clear();
+    gridPrepared = false;
+}
 
-    std::string level_path = levels_path("");
-    std::string levelFile = level_path + "dracula_level.csv";
-    CSVReader reader(levelFile);
-    std::vector<std::vector<char>> dataList = reader.getData();
-    for (int i = 0; i < dataList[0].size(); i++) {
-        std::vector<char> col;
-        col.reserve(9);
-        for (int j = 0; j < 9; j++) {
-            col.push_back(dataList[j][i]);
-        }
+void AStarSystem::prepareGrid() {
+    preparedGrid.clear();
+    preparedData.clear();
 
-    }
-    cols = dataList[0].size();
+    cols = (int) level_.width();
 
-    rows =21;
+    rows = (int) level_.height();
 
-    data.reserve(cols * rows);
+    preparedData.reserve(cols * rows);
 
 
     for(int i = 0; i<rows; i++){
         std::vector<Location*> row;
         for(int j=0; j<cols; j++){
-            size_t index = data.size();
-            data.push_back(Location(i, j));
-            row.push_back(&data.at(index));
-            if(dataList[i][j]=='1' || dataList[i][j]=='b'){
+            size_t index = preparedData.size();
+            preparedData.push_back(Location(i, j));
+            row.push_back(&preparedData.at(index));
+            if(level_.get_tile_at(j, i)=='1' || level_.get_tile_at(j, i)=='b'){
                 row[row.size()-1]->platform=true;
             }
 
         }
-        grid.push_back(row);
+        preparedGrid.push_back(row);
 
     }
 
     for (int i = 0; i < rows; i++) {
         for (int j = 0; j < cols; j++) {
-            grid[i][j]->addNeighbours(grid);
+            preparedGrid[i][j]->addNeighbours(preparedGrid);
         }
     }
-
+    gridPrepared = true;
 }
 
 Location* AStarSystem::getGridLocation(float x, float y){
@@ -95,7 +96,7 @@ Coordinates AStarSystem::getScreenLocation(int j, int i){
 std::vector<Coordinates> AStarSystem::getProjectilePath(Blackboard &blackboard, entt::DefaultRegistry &registry) {
     Location* start;
     Location* end;
-    std::vector<Location*> path;
+    FrameVector<Location*> path;
     std::vector<Coordinates> coordinatePath;
 
     auto dracula = registry.view<Dracula, Transform>();
@@ -122,7 +123,7 @@ std::vector<Coordinates> AStarSystem::getProjectilePath(Blackboard &blackboard,
     path = findPath(start, end);
 
 
-
+    coordinatePath.reserve(path.size());
     for(int i=0; i<path.size(); i++){
         Coordinates temp = getScreenLocation(path[i]->i,path[i]->j);
         coordinatePath.push_back(temp);
@@ -143,10 +144,11 @@ std::vector<Coordinates> AStarSystem::getProjectilePath(Blackboard &blackboard,
  * A* Pathfinding algorithm adapted from https://www.youtube.com/watch?v=aKYlikFAV4k
  * and Wikipedia pseudocode https://en.wikipedia.org/wiki/A*_search_algorithm
  */
-std::vector<Location*> AStarSystem::findPath(Location* start, Location* end){
-    std::vector<Location*> openSet;
-    std::vector<Location*> closedSet;
-    std::vector<Location*> path;
+FrameVector<Location*> AStarSystem::findPath(Location* start, Location* end){
+    // the search sets only live for this call, the path only until getProjectilePath converts it
+    FrameVector<Location*> openSet;
+    FrameVector<Location*> closedSet;
+    FrameVector<Location*> path;
     openSet.push_back(start);
 
     while(!openSet.empty()){
@@ -179,7 +181,7 @@ std::vector<Location*> AStarSystem::findPath(Location* start, Location* end){
         openSet.erase(openSet.begin()+best);
         closedSet.push_back(current);
 
-        std::vector<Location*> neighbours = current->neighbours;
+        const std::vector<Location*>& neighbours = current->neighbours;
         for(int i=0; i<neighbours.size(); i++){
             Location* neighbour = neighbours[i];
             if(!contains(closedSet, neighbour) && !neighbour->platform){
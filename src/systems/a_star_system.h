@@ -10,11 +10,12 @@
 #include "components/dracula.h"
 #include "components/transform.h"
 #include "components/collidable.h"
-#include "util/csv_reader.h"
+#include "level/level.h"
 #include "util/constants.h"
 #include <iostream>
 #include "util/Location.h"
 #include "util/coordinates.h"
+#include "util/frame_arena.h"
 
 class AStarSystem: public System{
 public:
@@ -22,7 +23,9 @@ public:
     void destroyGrid();
     virtual void update(Blackboard &blackboard, entt::DefaultRegistry &registry);
     void createGrid(Blackboard &blackboard, entt::DefaultRegistry &registry);
-    std::vector<Location*> findPath(Location* start, Location* end);
+    // builds the grid the next createGrid() takes, only reads the parsed level
+    void prepareGrid();
+    FrameVector<Location*> findPath(Location* start, Location* end);
     std::vector<Coordinates> getProjectilePath(Blackboard &blackboard, entt::DefaultRegistry &registry);
     Location* getGridLocation(float x, float y);
     Coordinates getScreenLocation(int i, int j);
@@ -31,10 +34,16 @@ public:
 private:
     float Y_OFFSET = 30.f;
     float X_OFFSET = -50.f;
+    // parsed once, the grid is rebuilt from it on every boss entry
+    Level level_;
     int cols=0;
     int rows=0;
     std::vector<std::vector<Location*>> grid;
     std::vector<Location> data;
+    // built by prepareGrid() ahead of an entry, moving the vectors keeps the neighbour pointers
+    std::vector<std::vector<Location*>> preparedGrid;
+    std::vector<Location> preparedData;
+    bool gridPrepared=false;
     bool startedInPlatform=false;
 };
 
@@ -161,3 +161,7 @@ void BackgroundTransformSystem::boss_dracula_background_transform(Blackboard &bl
         background.set_pos2(background.pos1().x + camera.size().x, background.pos1().y);
     }
 }
+
+SystemAccess BackgroundTransformSystem::access() const {
+    return SystemAccess().writes<Background>();
+}
@@ -25,6 +25,8 @@ public:
 
     virtual void update(Blackboard& blackboard, entt::DefaultRegistry& registry) override;
 
+    SystemAccess access() const;
+
     void horizontal_background_transform(Blackboard &blackboard, Background &background);
 
     void vertical_background_transform(Blackboard &blackboard, Background &background);
@@ -62,7 +62,7 @@ void EnemyAnimationSystem::update(Blackboard &blackboard, entt::DefaultRegistry
         auto &sprite = llama_view.get<Sprite>(llama_entity);
         auto& timer = llama_view.get<Timer>(llama_entity);
         float curr_time = timer.get_curr_time();
-        float target_time = timer.get_target_time("spit");
+        float target_time = timer.get_target_time(SPIT_TIMER_LABEL);
 
         bool alive = registry.has<Interactable>(llama_entity);
         animateLlama(alive, curr_time, target_time, sprite);
@@ -215,3 +215,8 @@ void EnemyAnimationSystem::animateBats(Sprite &sprite){
     vec2 uv2 = {(index+1)*batWidth, batHeight};
     sprite.set_uvs(uv1, uv2);
 }
+
+SystemAccess EnemyAnimationSystem::access() const {
+    return SystemAccess().reads<Bread, Interactable, Ghost, Jacko, Dracula, Chases, Boss, Spit, Llama, Timer, Seeks>()
+            .writes<Sprite>();
+}
@@ -6,6 +6,7 @@
 #define PANDAEXPRESS_ENEMY_ANIMATION_SYSTEM_H
 
 #include "system.h"
+#include "components/timer.h"
 
 
 class EnemyAnimationSystem : public System {
@@ -14,6 +15,8 @@ public:
 
     virtual void update(Blackboard &blackboard, entt::DefaultRegistry &registry) override;
 
+    SystemAccess access() const;
+
 private:
     const float breadWidth = 0.143;
     const float breadHeight = 0.5;
@@ -35,6 +38,7 @@ private:
     const int ghostFrames = 7;
     const int draculaFrames = 5;
     const int batFrames = 2;
+    const TimerLabel SPIT_TIMER_LABEL = Timer::label("spit");
     float animationTime = 0.f;
     float frameRate = 4.f;
     int counter = 0;
@@ -5,8 +5,9 @@
 #include <components/layer.h>
 #include "enemy_system.h"
 
-EnemySystem::EnemySystem():
-        ghost_movement_system()
+EnemySystem::EnemySystem(EntityPool& pool):
+        ghost_movement_system(),
+        pool_(pool)
 {};
 
 void EnemySystem::update(Blackboard &blackboard, entt::DefaultRegistry &registry, SceneType scene_type) {
@@ -22,14 +23,13 @@ void EnemySystem::update(Blackboard &blackboard, entt::DefaultRegistry &registry
 
 void EnemySystem::generate_projectile(float x, float y, bool spit_left, Blackboard &blackboard,
                                       entt::DefaultRegistry &registry) {
-    auto texture = blackboard.texture_manager.get_texture("spit");
-    auto shader = blackboard.shader_manager.get_shader("sprite");
-    auto mesh = blackboard.mesh_manager.get_mesh("sprite");
+    auto &prefab = pool_.prefab(SPIT_PREFAB, blackboard);
+    auto &texture = prefab.textures[0];
     auto scaleY = static_cast<float>(CELL_WIDTH / texture.width() / 2);
     float scaleX = scaleY;
-    auto projectile = registry.create();
+    auto projectile = pool_.acquire(registry, SPIT_PREFAB);
 
-    registry.assign<Sprite>(projectile, texture, shader, mesh);
+    registry.assign<Sprite>(projectile, prefab.sprites[0]);
     registry.assign<Spit>(projectile);
     registry.assign<CausesDamage>(projectile, TOP_VULNERABLE_MASK, 1);
     registry.assign<Health>(projectile, 1);
@@ -50,6 +50,13 @@ void EnemySystem::generate_projectile(float x, float y, bool spit_left, Blackboa
     registry.assign<Layer>(projectile, PROJECTILE_LAYER);
 }
 
+void EnemySystem::despawn(Blackboard &blackboard, uint32_t entity) {
+    EntityPool* pool = &pool_;
+    blackboard.commands.destroy(entity, [pool](entt::DefaultRegistry &registry, uint32_t entity) {
+        pool->despawn(registry, entity);
+    });
+}
+
 void EnemySystem::handle_bread(vec2 cam_position, vec2 cam_size, SceneType scene_type, Blackboard &blackboard,
                                entt::DefaultRegistry &registry){
     auto bread_view = registry.view<Bread, Transform, Velocity, Collidable>();
@@ -62,8 +69,8 @@ void EnemySystem::handle_bread(vec2 cam_position, vec2 cam_size, SceneType scene
         if (scene_type == JUNGLE_TYPE) {
             if (bread_transform.x + bread_collidable.width < cam_position.x - cam_size.x / 2 ||
                 bread_transform.y - bread_collidable.height > cam_position.y + cam_size.y / 2 + VERTICAL_BUFFER) {
-                registry.destroy(enemy_entity);
-                break;
+                despawn(blackboard, enemy_entity);
+                continue;
             }
             else if (!bread.started) {
                 if (bread_transform.x + bread_collidable.width / 2 < cam_position.x + cam_size.x / 2) {
@@ -75,8 +82,8 @@ void EnemySystem::handle_bread(vec2 cam_position, vec2 cam_size, SceneType scene
             if (bread_transform.x + bread_collidable.width < cam_position.x - cam_size.x / 2 ||
                 bread_transform.y - bread_collidable.height > cam_position.y + cam_size.y / 2 ||
                 bread_transform.x + bread_collidable.width / 2 > cam_position.x + cam_size.x / 2) {
-                registry.destroy(enemy_entity);
-                break;
+                despawn(blackboard, enemy_entity);
+                continue;
             }
             else if (!bread.started) {
                 if (bread_transform.y + bread_collidable.height < cam_position.y - cam_size.y) {
@@ -101,14 +108,14 @@ void EnemySystem::handle_ghosts(vec2 cam_position, vec2 cam_size, SceneType scen
         if (scene_type == JUNGLE_TYPE) {
             if (ghost_transform.x + ghost_collidable.width < cam_position.x - cam_size.x / 2 ||
                 ghost_transform.y - ghost_collidable.height > cam_position.y + cam_size.y / 2 + VERTICAL_BUFFER) {
-                registry.destroy(enemy_entity);
-                break;
+                despawn(blackboard, enemy_entity);
+                continue;
             }
         } else if (scene_type == SKY_TYPE) {
             if (ghost_transform.x + ghost_collidable.width < cam_position.x - cam_size.x / 2 ||
                 ghost_transform.y - ghost_collidable.height > cam_position.y + cam_size.y / 2) {
-                registry.destroy(enemy_entity);
-                break;
+                despawn(blackboard, enemy_entity);
+                continue;
             }
         }
     }
@@ -126,12 +133,12 @@ void EnemySystem::handle_llamas(vec2 cam_position, vec2 cam_size, SceneType scen
         if (scene_type == JUNGLE_TYPE) {
             if (llama_transform.x + llama_collidable.width < cam_position.x - cam_size.x / 2 ||
                 llama_transform.y - llama_collidable.height > cam_position.y + cam_size.y / 2 + VERTICAL_BUFFER) {
-                registry.destroy(enemy_entity);
-                break;
+                despawn(blackboard, enemy_entity);
+                continue;
             }
 
             if (!llama.alive)
-                break;
+                continue;
 
             if (llama_timer.is_done(SPIT_TIMER_LABEL)) {
                 generate_projectile(llama_transform.x, llama_transform.y, true, blackboard, registry);
@@ -143,12 +150,12 @@ void EnemySystem::handle_llamas(vec2 cam_position, vec2 cam_size, SceneType scen
             if (llama_transform.x + llama_collidable.width < cam_position.x - cam_size.x / 2 ||
                 llama_transform.y - llama_collidable.height > cam_position.y + cam_size.y / 2 ||
                 llama_transform.x + llama_collidable.width / 2 > cam_position.x + cam_size.x / 2) {
-                registry.destroy(enemy_entity);
-                break;
+                despawn(blackboard, enemy_entity);
+                continue;
             }
 
             if (!llama.alive)
-                break;
+                continue;
 
             for (auto panda_entity : pandas_view) {
                 auto &pa_transform = pandas_view.get<Transform>(panda_entity);
@@ -179,22 +186,22 @@ void EnemySystem::handle_spit(vec2 cam_position, vec2 cam_size, SceneType scene_
         auto &spit_collidable = spit_view.get<Collidable>(enemy_entity);
 
         if (spit.hit) {
-            registry.destroy(enemy_entity);
+            despawn(blackboard, enemy_entity);
             continue;
         }
 
         if (scene_type == JUNGLE_TYPE) {
             if (spit_transform.x + spit_collidable.width < cam_position.x - cam_size.x / 2 ||
                 spit_transform.y - spit_collidable.height > cam_position.y + cam_size.y / 2 + VERTICAL_BUFFER) {
-                registry.destroy(enemy_entity);
-                break;
+                despawn(blackboard, enemy_entity);
+                continue;
             }
         } else if (scene_type == SKY_TYPE) {
             if (spit_transform.x + spit_collidable.width < cam_position.x - cam_size.x / 2 ||
                 spit_transform.y - spit_collidable.height > cam_position.y + cam_size.y / 2 ||
                 spit_transform.x + spit_collidable.width / 2 > cam_position.x + cam_size.x / 2) {
-                registry.destroy(enemy_entity);
-                break;
+                despawn(blackboard, enemy_entity);
+                continue;
             }
         }
     }
@@ -21,12 +21,15 @@
 class EnemySystem {
 private:
     GhostMovementSystem ghost_movement_system;
+    EntityPool& pool_;
     const float BREAD_SPEED = 50.f;
     const float PROJECTILE_SPEED_X = -300.f;
     const float PROJECTILE_SPEED_Y = 10.f;
-    const std::string SPIT_TIMER_LABEL = "spit";
+    const TimerLabel SPIT_TIMER_LABEL = Timer::label("spit");
     const float VERTICAL_BUFFER = 300.f;
 
+    // hands the entity back to the pool at the next command flush, so the views stay intact
+    void despawn(Blackboard &blackboard, uint32_t entity);
     void generate_projectile(float x, float y, bool spit_left, Blackboard &blackboard, entt::DefaultRegistry &registry);
     void handle_bread(vec2 cam_position, vec2 cam_size, SceneType scene_type, Blackboard &blackboard,
                       entt::DefaultRegistry &registry);
@@ -39,7 +42,7 @@ private:
 
 
 public:
-    EnemySystem();
+    EnemySystem(EntityPool& pool);
     virtual void update(Blackboard &blackboard, entt::DefaultRegistry &registry, SceneType scene_type);
 };
 
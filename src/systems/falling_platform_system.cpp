@@ -4,9 +4,21 @@
 
 #include "falling_platform_system.h"
 
+FallingPlatformSystem::FallingPlatformSystem(const TimerSystem& timers) : timers_(timers) {}
 
 void FallingPlatformSystem::update(Blackboard& blackboard, entt::DefaultRegistry& registry) {
 
+    for (auto& expiry : timers_.expired()) {
+        auto entity = expiry.entity;
+        if (expiry.label != FALL || !registry.valid(entity) ||
+            !registry.has<Platform>(entity) || !registry.has<Timer>(entity)) {
+            continue;
+        }
+        registry.get<Platform>(entity).shaking = false;
+        registry.assign<ObeysGravity>(entity, 1.4f);
+        registry.remove<Timer>(entity);
+    }
+
     auto falling_platform_view = registry.view<Platform, Transform, Timer>();
     for (auto falling_platform_entity : falling_platform_view) {
 
@@ -27,13 +39,7 @@ void FallingPlatformSystem::update(Blackboard& blackboard, entt::DefaultRegistry
             platform.shakeLeft=!platform.shakeLeft;
         }
 
-        if(platform_timer.watch_exists(FALL)){
-            if(platform_timer.is_done(FALL)) {
-                platform.shaking = false;
-                registry.assign<ObeysGravity>(falling_platform_entity,1.4f);
-                registry.remove<Timer>(falling_platform_entity);
-            }
-        }else{
+        if(!platform_timer.watch_exists(FALL)){
             platform_timer.save_watch(FALL, WARNING_TIME);
         }
 
@@ -19,13 +19,18 @@
 #include <components/jacko.h>
 #include <components/chases.h>
 #include <components/timer.h>
+#include "timer_system.h"
 
 class FallingPlatformSystem {
 public:
 
+    // platforms drop when the scene's timer system reports their warning ran out
+    explicit FallingPlatformSystem(const TimerSystem& timers);
+
     void update(Blackboard& blackboard, entt::DefaultRegistry& registry);
 private:
-    const std::string FALL = "FALL";
+    const TimerSystem& timers_;
+    const TimerLabel FALL = Timer::label("FALL");
     const float WARNING_TIME = 0.6f;
 };
 
@@ -52,4 +52,8 @@ void HealthBarTransformSystem::update(Blackboard &blackboard, entt::DefaultRegis
         healthBar.set_rotation_rad(transform.theta);
         healthBar.set_health(health.health_points / (float) health.max_health);
     }
-}
\ No newline at end of file
+}
+
+SystemAccess HealthBarTransformSystem::access() const {
+    return SystemAccess().reads<Panda, Boss, Health, Transform>().writes<HealthBar>();
+}
@@ -15,6 +15,8 @@ public:
     HealthBarTransformSystem();
 
     virtual void update(Blackboard &blackboard, entt::DefaultRegistry &registry) override;
+
+    SystemAccess access() const;
 };
 
 
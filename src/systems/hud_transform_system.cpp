@@ -27,3 +27,7 @@ void HudTransformSystem::update(Blackboard &blackboard, entt::DefaultRegistry &r
         text.set_pos(blackboard.camera.get_relative_pos(hud.position));
     }
 }
+
+SystemAccess HudTransformSystem::access() const {
+    return SystemAccess().reads<HudElement>().writes<HealthBar, Text>();
+}
@@ -14,6 +14,8 @@ public:
     HudTransformSystem();
 
     void update(Blackboard &blackboard, entt::DefaultRegistry &registry) override;
+
+    SystemAccess access() const;
 };
 
 
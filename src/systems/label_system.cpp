@@ -13,6 +13,10 @@ LabelSystem::LabelSystem() {
 
 }
 
+SystemAccess LabelSystem::access() const {
+    return SystemAccess().writes<Label, Text, Transform>();
+}
+
 void LabelSystem::update(Blackboard &blackboard, entt::DefaultRegistry &registry) {
     auto labelViews = registry.view<Text, Label, Transform>();
     for (auto entity:labelViews) {
@@ -23,11 +27,8 @@ void LabelSystem::update(Blackboard &blackboard, entt::DefaultRegistry &registry
         transform.y -= blackboard.delta_time * 10.0f; // move up
         transform.x_scale += blackboard.delta_time * 1.0f; // scale up
         text.set_opacity(label.opacity);
-    }
-    for (auto entity: labelViews) { // Destroy invisible labels
-        auto &label = labelViews.get<Label>(entity);
-        if (label.opacity == 0.0f) {
-            registry.destroy(entity);
+        if (label.opacity == 0.0f) { // Destroy invisible labels
+            blackboard.commands.destroy(entity);
         }
     }
 }
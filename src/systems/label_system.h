@@ -12,6 +12,8 @@ class LabelSystem : public System {
 public:
     LabelSystem();
     void update(Blackboard &blackboard, entt::DefaultRegistry &registry);
+    // faded labels are destroyed through the command buffer, so no exclusive access is needed
+    SystemAccess access() const;
 };
 
 
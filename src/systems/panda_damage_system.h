@@ -8,14 +8,15 @@
 
 #include "system.h"
 #include <string>
+#include <components/timer.h>
 
 class PandaDamageSystem: System {
 private:
     const float DMG_INVINCIBLE_TIMER = 1.f;
     const float DMG_REACTION_X = 200.f;
     const float DMG_REACTION_Y = -1000.f;
-    const std::string DMG_TIMER_LABEL = "dmg_invincible";
-    const std::string DEATH_TIMER_LABEL = "dying";
+    const TimerLabel DMG_TIMER_LABEL = Timer::label("dmg_invincible");
+    const TimerLabel DEATH_TIMER_LABEL = Timer::label("dying");
     const float DEATH_TIMER = 2.5f;
 
 public:
@@ -6,6 +6,9 @@
 
 #include "physics_system.h"
 #include <numeric>
+#include <util/job_system.h>
+#include <util/frame_arena.h>
+#include <util/constants.h>
 #include <components/panda.h>
 #include <components/causes_damage.h>
 #include <components/health.h>
@@ -26,16 +29,39 @@
 
 #include "util/scene_helper.h"
 
-PhysicsSystem::PhysicsSystem(): story_(false) {}
+PhysicsSystem::PhysicsSystem(): story_(false), pool_(nullptr) {}
+
+PhysicsSystem::PhysicsSystem(EntityPool& pool): story_(false), pool_(&pool) {}
 
 void PhysicsSystem::update(Blackboard& blackboard, entt::DefaultRegistry& registry) {
 
+    sort_pools(registry);
     apply_gravity(blackboard, registry);
     check_collisions(blackboard, registry);
     apply_velocity(blackboard, registry);
 }
 
 
+void PhysicsSystem::despawn(Blackboard &blackboard, uint32_t entity) {
+    if (pool_ == nullptr) {
+        blackboard.commands.destroy(entity);
+        return;
+    }
+    EntityPool* pool = pool_;
+    blackboard.commands.destroy(entity, [pool](entt::DefaultRegistry &registry, uint32_t entity) {
+        pool->despawn(registry, entity);
+    });
+}
+
+void PhysicsSystem::sort_pools(entt::DefaultRegistry &registry) {
+    // moving bodies first and in the same order in Velocity, Transform and Collidable, so the loops
+    // below and the sprite transforms stream through the pools instead of jumping around them.
+    // Once sorted this is a linear pass with few swaps, only spawns and despawns disturb the order
+    registry.sort<Transform, Velocity>();
+    registry.sort<Collidable, Transform>();
+    registry.view<Velocity, Transform>(entt::persistent_t{}).sort<Velocity>();
+}
+
 void PhysicsSystem::apply_gravity(Blackboard &blackboard, entt::DefaultRegistry &registry){
     /***
      * Applying gravity to objects that can walk on platforms
@@ -70,16 +96,15 @@ void PhysicsSystem::apply_gravity(Blackboard &blackboard, entt::DefaultRegistry
 
 void PhysicsSystem::apply_velocity(Blackboard &blackboard, entt::DefaultRegistry &registry) {
 
-    auto view = registry.view<Velocity, Transform>();
-
+    auto view = registry.view<Velocity, Transform>(entt::persistent_t{});
+    float delta_time = blackboard.delta_time;
 
-    for (auto entity: view) {
+    JobSystem::instance().parallel_each(view, PARALLEL_GRAIN, [&view, delta_time](uint32_t entity) {
         auto& transform = view.get<Transform>(entity);
         auto& velocity = view.get<Velocity>(entity);
-        transform.x += velocity.x_velocity * blackboard.delta_time;
-        transform.y += velocity.y_velocity * blackboard.delta_time;
-
-    }
+        transform.x += velocity.x_velocity * delta_time;
+        transform.y += velocity.y_velocity * delta_time;
+    });
 }
 
 void PhysicsSystem::check_collisions(Blackboard &blackboard, entt::DefaultRegistry &registry) {
@@ -90,7 +115,20 @@ void PhysicsSystem::check_collisions(Blackboard &blackboard, entt::DefaultRegist
 
     auto static_view = registry.view<Collidable, Transform>();
 
-    auto recorded_collisions = std::unordered_set<uint_pair, PairHash>();
+    // nothing below moves a transform or resizes a collider, and destroys wait for the command
+    // flush, so the static side can be copied once per frame; velocities change and stay pointers
+    bodies_.clear();
+    for (auto s_entity : static_view) {
+        const Velocity* velocity = registry.has<Velocity>(s_entity) ? &registry.get<Velocity>(s_entity) : nullptr;
+        bodies_.emplace_back(s_entity, static_view.get<Collidable>(s_entity), static_view.get<Transform>(s_entity),
+                             velocity);
+    }
+
+    // per-frame scratch from the frame arena, the entry lists are cleared and reused per sweep
+    auto recorded_collisions = FrameUnorderedSet<uint_pair, PairHash>();
+    auto collisions = FrameVector<CollisionEntry>();
+    auto sorted_collisions = FrameVector<CollisionEntry>();
+    collisions.reserve(bodies_.size());
 
     for (auto d_entity : dynamic_view) {
         auto& interactible = dynamic_view.get<Interactable>(d_entity);
@@ -102,13 +140,14 @@ void PhysicsSystem::check_collisions(Blackboard &blackboard, entt::DefaultRegist
         // check for collisions and adjust velocity
         // until no more collisions
         while (!no_collisions) {
-            auto collisions = std::vector<CollisionEntry>();
+            collisions.clear();
 
             auto &dc = dynamic_view.get<Collidable>(d_entity);
             auto &dp = dynamic_view.get<Transform>(d_entity);
             auto &dv = dynamic_view.get<Velocity>(d_entity);
 
-            for (auto s_entity: static_view) {
+            for (auto& body : bodies_) {
+                auto s_entity = body.entity;
                 // if the entities are the same
                 if (d_entity == s_entity) {
                     continue;
@@ -120,13 +159,10 @@ void PhysicsSystem::check_collisions(Blackboard &blackboard, entt::DefaultRegist
 
                 float time, x_norm, y_norm;
 
-                auto &sc = static_view.get<Collidable>(s_entity);
-                auto &sp = static_view.get<Transform>(s_entity);
+                auto &sc = body.collider;
+                auto &sp = body.position;
                 auto null_v = Velocity(0, 0);
-                auto& sv = null_v;
-                if (registry.has<Velocity>(s_entity)) {
-                    sv = registry.get<Velocity>(s_entity);
-                }
+                auto& sv = body.velocity ? *body.velocity : null_v;
 
                 //sets time and normals (if applicable) of collision
 
@@ -154,7 +190,7 @@ void PhysicsSystem::check_collisions(Blackboard &blackboard, entt::DefaultRegist
             }
 
             //sort collisions by first-occurring
-            auto sorted_collisions = std::vector<CollisionEntry>();
+            sorted_collisions.clear();
 
             for (auto entry : collisions) {
                 if (entry.time == 1) {
@@ -342,6 +378,10 @@ void PhysicsSystem::check_collisions(Blackboard &blackboard, entt::DefaultRegist
                     }
 
                     //check for food
+                    // food and powerups stay in the views until the flush, only the first taker gets them
+                    if (blackboard.commands.destroying(entry.e1)) {
+                        continue;
+                    }
                     if ( registry.has<Food>(entry.e1)) {
                         if (registry.has<Panda>(d_entity)) {
                             auto &panda = registry.get<Panda>(d_entity);
@@ -349,7 +389,7 @@ void PhysicsSystem::check_collisions(Blackboard &blackboard, entt::DefaultRegist
                             if (panda.alive && health.health_points < health.max_health) {
                                 health.health_points++;
                             }
-                            registry.destroy(entry.e1);
+                            despawn(blackboard, entry.e1);
                             continue;
 
                         } else if (registry.has<Food>(entry.e1) && registry.has<Jacko>(d_entity)) {
@@ -357,7 +397,7 @@ void PhysicsSystem::check_collisions(Blackboard &blackboard, entt::DefaultRegist
                             if (health.health_points < health.max_health) {
                                 health.health_points++;
                             }
-                            registry.destroy(entry.e1);
+                            despawn(blackboard, entry.e1);
                             continue;
                         }
                     }
@@ -368,7 +408,7 @@ void PhysicsSystem::check_collisions(Blackboard &blackboard, entt::DefaultRegist
                         if (panda.alive) {
                             panda.powerups.push(powerup.powerup_type);
                         }
-                        registry.destroy(entry.e1);
+                        despawn(blackboard, entry.e1);
                         continue;
                     }
 
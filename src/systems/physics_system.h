@@ -8,12 +8,14 @@
 #include <cstdint>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 #include "system.h"
 #include "components/obeys_gravity.h"
 #include "components/collidable.h"
 #include "components/interactable.h"
 #include "components/velocity.h"
 #include "components/transform.h"
+#include "level/entity_pool.h"
 
 static const int BREAD_KILL_POINTS = 50;
 static const int LLAMA_KILL_POINTS = 150;
@@ -48,20 +50,42 @@ struct CollisionEntry {
     {}
 };
 
+// Everything check_collisions needs from the other side of a pair, packed so the inner loop walks
+// one array instead of probing the Collidable, Transform and Velocity pools for every pair
+struct PhysicsBody {
+    uint32_t entity;
+    Collidable collider;
+    Transform position;
+    const Velocity* velocity; // live, other bodies may have been slowed earlier in the solve
+
+    PhysicsBody(uint32_t entity, const Collidable& collider, const Transform& position, const Velocity* velocity) :
+        entity(entity),
+        collider(collider),
+        position(position),
+        velocity(velocity)
+    {}
+};
+
 class PhysicsSystem : public System{
 private:
     static constexpr float GRAVITY = 2500.f;
     static constexpr float METER = 100.f;
 
     bool story_;
+    EntityPool* pool_; // where picked up food and powerups go back to, null in scenes without a level
+    std::vector<PhysicsBody> bodies_;
 public:
 
     PhysicsSystem();
+    explicit PhysicsSystem(EntityPool& pool);
     virtual void update(Blackboard& blackboard, entt::DefaultRegistry& registry) override;
     void set_story(bool story);
 private:
 
 
+    void sort_pools(entt::DefaultRegistry &registry);
+    // hands a picked up entity back to the pool at the next command flush
+    void despawn(Blackboard &blackboard, uint32_t entity);
     void apply_gravity(Blackboard &blackboard, entt::DefaultRegistry &registry);
     void apply_velocity(Blackboard &blackboard, entt::DefaultRegistry &registry);
 
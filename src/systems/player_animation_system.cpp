@@ -155,3 +155,8 @@ void PlayerAnimationSystem::animate(bool alive, int frames, int index, int row,
     vec2 uv2 = {(index + 1) * pandawidth + w2, pandaheight * (1 + row) - h2};
     sprite.set_uvs(uv1, uv2);
 }
+
+SystemAccess PlayerAnimationSystem::access() const {
+    // writes Transform to flip x_scale towards the input
+    return SystemAccess().reads<Panda, Interactable>().writes<Sprite, Transform>();
+}
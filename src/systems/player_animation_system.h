@@ -18,6 +18,8 @@ public:
 
     virtual void update(Blackboard &blackboard, entt::DefaultRegistry &registry) override;
 
+    SystemAccess access() const;
+
 
 private:
     const float pandawidth = 0.1f;
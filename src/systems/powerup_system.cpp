@@ -20,11 +20,12 @@ void PowerupSystem::update(Blackboard &blackboard, entt::DefaultRegistry &regist
                     panda.invincible = true;
                     timer.save_watch(SHIELD_TIMER_LABEL, SHIELD_TIMER_LENGTH);
                     sprite.set_color(72 / 256.f, 219 / 256.f, 251 / 256.f);
+                    add_shield_glow(blackboard);
                     blackboard.soundManager.changeBackgroundMusic(INVINCIBILITY_MUSIC);
                     break;
                 case VAPE_POWERUP:
                     blackboard.time_multiplier *= 0.6f;
-                    blackboard.post_process_shader = std::make_unique<Shader>(
+                    blackboard.post_process_chain.add_pass(VAPE_PASS,
                             blackboard.shader_manager.get_shader("shift"));
                     timer.save_watch(VAPE_TIMER_LABEL, VAPE_TIMER_LENGTH);
                     if(blackboard.soundManager.currentStage==STORY_EASY_JUNGLE_SCENE_ID || blackboard.soundManager.currentStage==ENDLESS_JUNGLE_SCENE_ID
@@ -59,6 +60,7 @@ void PowerupSystem::update(Blackboard &blackboard, entt::DefaultRegistry &regist
             if (timer.is_done(SHIELD_TIMER_LABEL)) {
                 panda.invincible = false;
                 timer.remove(SHIELD_TIMER_LABEL);
+                remove_shield_glow(blackboard);
                 if(timer.watch_exists(VAPE_TIMER_LABEL)){
                     if(blackboard.soundManager.currentStage==1 || blackboard.soundManager.currentStage==4
                        || blackboard.soundManager.currentStage==7){
@@ -76,12 +78,10 @@ void PowerupSystem::update(Blackboard &blackboard, entt::DefaultRegistry &regist
         if (timer.exists(VAPE_TIMER_LABEL)) {
             float val = (((timer.get_target_time(VAPE_TIMER_LABEL) - timer.get_curr_time()) /
                               VAPE_TIMER_LENGTH));
-            blackboard.post_process_shader->bind();
-            blackboard.post_process_shader->set_uniform_float("timeElapsed", val);
-            blackboard.post_process_shader->unbind();
+            blackboard.post_process_chain.set_uniform_float(VAPE_PASS, "timeElapsed", val);
             blackboard.time_multiplier = fmax(0.5f, 1 - val);
             if (timer.is_done(VAPE_TIMER_LABEL)) {
-                blackboard.post_process_shader = std::make_unique<Shader>(blackboard.shader_manager.get_shader("sprite"));
+                blackboard.post_process_chain.remove_pass(VAPE_PASS);
                 if(timer.watch_exists(SHIELD_TIMER_LABEL)){
                     blackboard.soundManager.changeBackgroundMusic(INVINCIBILITY_MUSIC);
                 }else{
@@ -92,4 +92,18 @@ void PowerupSystem::update(Blackboard &blackboard, entt::DefaultRegistry &regist
             }
         }
     }
-}
\ No newline at end of file
+}
+
+void PowerupSystem::add_shield_glow(Blackboard &blackboard) {
+    auto& chain = blackboard.post_process_chain;
+    chain.add_pass(SHIELD_EDGE_PASS, blackboard.shader_manager.get_shader("edge"), QUARTER_SCALE, FULL_SCALE_INPUT);
+    chain.add_pass(SHIELD_BLUR_PASS, blackboard.shader_manager.get_shader("blur"), QUARTER_SCALE);
+    chain.add_pass(SHIELD_GLOW_PASS, blackboard.shader_manager.get_shader("glow"));
+}
+
+void PowerupSystem::remove_shield_glow(Blackboard &blackboard) {
+    auto& chain = blackboard.post_process_chain;
+    chain.remove_pass(SHIELD_EDGE_PASS);
+    chain.remove_pass(SHIELD_BLUR_PASS);
+    chain.remove_pass(SHIELD_GLOW_PASS);
+}
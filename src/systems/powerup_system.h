@@ -8,13 +8,21 @@
 
 #include <util/blackboard.h>
 #include <entt/entity/registry.hpp>
+#include <components/timer.h>
 
 class PowerupSystem {
 private:
-    const std::string SHIELD_TIMER_LABEL = "shield_powerup";
-    const std::string VAPE_TIMER_LABEL = "vape_powerup";
+    const TimerLabel SHIELD_TIMER_LABEL = Timer::label("shield_powerup");
+    const TimerLabel VAPE_TIMER_LABEL = Timer::label("vape_powerup");
     const float SHIELD_TIMER_LENGTH = 8.f;
     const float VAPE_TIMER_LENGTH = 10.f;
+    // the shield's glow: edges found and blurred at quarter scale, added over the image at full scale
+    const std::string SHIELD_EDGE_PASS = "shield_edge";
+    const std::string SHIELD_BLUR_PASS = "shield_blur";
+    const std::string SHIELD_GLOW_PASS = "shield_glow";
+
+    void add_shield_glow(Blackboard& blackboard);
+    void remove_shield_glow(Blackboard& blackboard);
 public:
     void update(Blackboard& blackboard, entt::DefaultRegistry& registry);
 };
@@ -22,7 +22,7 @@ struct CompareRenderable {
 
 void RenderSystem::update(Blackboard &blackboard, entt::DefaultRegistry &registry) {
     updateLayers(registry);
-    std::vector<Renderable *> allRenderables;
+    FrameVector<Renderable *> allRenderables;
     auto viewSprites = registry.view<Sprite>();
     for (auto entity: viewSprites) {
         auto &r = viewSprites.get(entity);
@@ -59,8 +59,20 @@ void RenderSystem::update(Blackboard &blackboard, entt::DefaultRegistry &registr
         allRenderables.push_back(&r);
     }
     sort(allRenderables.begin(), allRenderables.end(), layerComparator);
-    for (auto render : allRenderables) {
-        blackboard.window.draw((Renderable *) render, blackboard.camera.get_projection());
+
+    if (sprite_shader_ == INVALID_RESOURCE_HANDLE) {
+        sprite_shader_ = blackboard.shader_manager.handle(SPRITE_SHADER);
+        sprite_mesh_ = blackboard.mesh_manager.handle(SPRITE_MESH);
+    }
+    auto& projection = blackboard.camera.get_projection();
+    size_t cached = layer_cache_.update(allRenderables, projection, blackboard.window,
+                                        blackboard.shader_manager.get_shader(sprite_shader_),
+                                        blackboard.mesh_manager.get_mesh(sprite_mesh_));
+    if (cached > 0) {
+        blackboard.window.draw(&layer_cache_, layer_cache_.screen_projection());
+    }
+    for (size_t i = cached; i < allRenderables.size(); i++) {
+        blackboard.window.draw(allRenderables[i], projection);
     }
 }
 
@@ -7,16 +7,23 @@
 
 
 #include "system.h"
+#include <graphics/layer_cache.h>
 
 /**
  * Main Render System, compiles a vector of all renderables, then sorts them according to their
- * depth values and renders them
+ * depth values and renders them. Static layers at the bottom (backgrounds, caves) are drawn
+ * from a LayerCache texture while they and the camera stay still
  */
 class RenderSystem : public System {
 public:
     void update(Blackboard &blackboard, entt::DefaultRegistry &registry);
 
 private:
+    LayerCache layer_cache_;
+    // resolved on the first update, the managers load everything before any scene renders
+    ShaderHandle sprite_shader_ = INVALID_RESOURCE_HANDLE;
+    MeshHandle sprite_mesh_ = INVALID_RESOURCE_HANDLE;
+
     void updateLayers(entt::DefaultRegistry &registry);
 };
 
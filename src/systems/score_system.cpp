@@ -5,8 +5,7 @@
 #include <components/score.h>
 #include <graphics/text.h>
 #include <components/transform.h>
-#include <sstream>
-#include <iomanip>
+#include <cstdio>
 #include "score_system.h"
 #include "util/constants.h"
 
@@ -19,10 +18,9 @@ void ScoreSystem::update(Blackboard &blackboard, entt::DefaultRegistry &registry
     for (auto entity: view) {
         auto &text = view.get<Text>(entity);
         blackboard.score += blackboard.delta_time * POINTS_SPEED;
-        std::string score_text;
-        std::stringstream ss;
-        ss << std::setfill('0') << std::setw(7) << (int) blackboard.score;
-        score_text = ss.str();
+        // seven digits fit the small string buffer, so no stream or heap allocation per frame
+        char score_text[16];
+        snprintf(score_text, sizeof(score_text), "%07d", (int) blackboard.score);
         text.set_text(score_text);
     }
     blackboard.time_multiplier += blackboard.delta_time * TIME_MULTIPLIER_SPEED;
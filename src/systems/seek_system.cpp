@@ -12,6 +12,8 @@
 
 using namespace std;
 
+static const TimerLabel BAT_TIMER_LABEL = Timer::label("batTimer");
+
 SeekSystem::SeekSystem() {}
 
 
@@ -98,15 +100,15 @@ void SeekSystem::update(Blackboard &blackboard, entt::DefaultRegistry& registry)
 
 
         }else{
-            if(timer.watch_exists("batTimer")){
+            if(timer.watch_exists(BAT_TIMER_LABEL)){
                 velocity.x_velocity=0;
                 velocity.y_velocity=0;
 
-                if(timer.is_done("batTimer")){
+                if(timer.is_done(BAT_TIMER_LABEL)){
                     registry.destroy(entity);
                 }
             }else{
-                timer.save_watch("batTimer", 1.f);
+                timer.save_watch(BAT_TIMER_LABEL, 1.f);
                 seeks.batDirection=Seeks::WAITING;
             }
             seeks.seekList.clear();
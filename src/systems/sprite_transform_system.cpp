@@ -3,26 +3,45 @@
 //
 
 #include <components/panda.h>
+#include <components/static.h>
 #include "sprite_transform_system.h"
 
 #include "components/transform.h"
 #include "../graphics/sprite.h"
+#include "../util/job_system.h"
+#include "../util/constants.h"
 
 SpriteTransformSystem::SpriteTransformSystem() {}
 
 void SpriteTransformSystem::update(Blackboard &blackboard, entt::DefaultRegistry& registry) {
     // construct a view for all entites with a position and sprite component
-    auto view = registry.view<Transform, Sprite>();
+    // persistent so its entities are contiguous and can be split across the job system
+    auto view = registry.view<Transform, Sprite>(entt::persistent_t{});
+    // follow the Transform order physics keeps; the Sprite pool itself is left alone since
+    // the renderer's layer sort is not stable and would reorder sprites sharing a layer
+    view.sort<Transform>();
+
+    JobSystem::instance().parallel_each(view, PARALLEL_GRAIN, [&view, &registry](uint32_t entity) {
+        // terrain keeps the position it spawned at, its sprite only needs syncing once
+        if (registry.has<Static>(entity)) {
+            auto& marker = registry.get<Static>(entity);
+            if (marker.synced) {
+                return;
+            }
+            marker.synced = true;
+        }
 
-    // foreach loop over all entities in view
-    for (auto entity: view) {
         //get the position and sprite for the current entity
         auto& transform = view.get<Transform>(entity);
         auto& sprite = view.get<Sprite>(entity);
 
-        //transform the sprite
+        //transform the sprite, the setters leave its matrix alone unless something actually moved
         sprite.set_pos((int)transform.x, (int)transform.y);
         sprite.set_rotation_rad(transform.theta);
         sprite.set_scale_int(transform.x_scale, transform.y_scale);
-    }
+    });
+}
+
+SystemAccess SpriteTransformSystem::access() const {
+    return SystemAccess().reads<Transform>().writes<Sprite, Static>().persistent<Transform, Sprite>();
 }
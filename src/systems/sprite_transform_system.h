@@ -10,4 +10,6 @@ class SpriteTransformSystem : public System {
 public:
     SpriteTransformSystem();
     virtual void update(Blackboard& blackboard, entt::DefaultRegistry& registry) override;
+
+    SystemAccess access() const;
 };
@@ -4,10 +4,98 @@
 
 #pragma once
 
+#include <vector>
 #include <entt/entity/registry.hpp>
 
 #include "../util/blackboard.h"
 
 class System {
     virtual void update(Blackboard& blackboard, entt::DefaultRegistry& registry) = 0;
-};
\ No newline at end of file
+};
+
+// Components a system reads and writes, declared so the SystemScheduler can run systems
+// that don't conflict at the same time. Every system may read the blackboard; systems that
+// write to it, create or destroy entities, or add or remove components must be exclusive.
+class SystemAccess {
+public:
+    typedef entt::DefaultRegistry::component_type component_type;
+
+    SystemAccess() : exclusive_(false) {}
+
+    static SystemAccess exclusive_access() {
+        SystemAccess access;
+        access.exclusive_ = true;
+        return access;
+    }
+
+    template<typename... Components>
+    SystemAccess& reads() {
+        int expand[] = {0, (add<Components>(reads_), 0)...};
+        (void) expand;
+        return *this;
+    }
+
+    template<typename... Components>
+    SystemAccess& writes() {
+        int expand[] = {0, (add<Components>(writes_), 0)...};
+        (void) expand;
+        return *this;
+    }
+
+    // persistent views the system iterates, built up front since building one changes the registry
+    template<typename... Components>
+    SystemAccess& persistent() {
+        assures_.push_back(&SystemAccess::prepare_view<Components...>);
+        return *this;
+    }
+
+    bool exclusive() const { return exclusive_; }
+
+    // true if the two can't run at the same time
+    bool conflicts(const SystemAccess& other) const {
+        return exclusive_ || other.exclusive_ ||
+               overlaps(writes_, other.writes_) || overlaps(writes_, other.reads_) ||
+               overlaps(reads_, other.writes_);
+    }
+
+    // creates the pools of every declared component and the declared persistent views,
+    // views can't do that safely off the main thread
+    void assure(entt::DefaultRegistry& registry) const {
+        for (auto create : assures_) {
+            create(registry);
+        }
+    }
+
+private:
+    bool exclusive_;
+    std::vector<component_type> reads_;
+    std::vector<component_type> writes_;
+    std::vector<void (*)(entt::DefaultRegistry&)> assures_;
+
+    template<typename Component>
+    static void assure_pool(entt::DefaultRegistry& registry) {
+        registry.reserve<Component>(0);
+    }
+
+    template<typename... Components>
+    static void prepare_view(entt::DefaultRegistry& registry) {
+        registry.prepare<Components...>();
+    }
+
+    template<typename Component>
+    void add(std::vector<component_type>& types) {
+        types.push_back(entt::DefaultRegistry::type<Component>());
+        assures_.push_back(&SystemAccess::assure_pool<Component>);
+    }
+
+    static bool overlaps(const std::vector<component_type>& a, const std::vector<component_type>& b) {
+        for (auto type : a) {
+            for (auto other : b) {
+                if (type == other) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+};
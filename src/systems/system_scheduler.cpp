@@ -0,0 +1,100 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include "util/job_system.h"
+#include "system_scheduler.h"
+
+SystemScheduler::SystemScheduler() :
+        pools_ready_(false),
+        runs_(0),
+        wall_ms_(0) {
+}
+
+void SystemScheduler::add_step(const std::string& name, Step step, SystemAccess access) {
+    steps_.push_back({name, std::move(step), std::move(access), 0});
+    waves_.clear();
+    pools_ready_ = false;
+}
+
+void SystemScheduler::build_waves() {
+    std::vector<size_t> wave_of(steps_.size(), 0);
+    for (size_t j = 0; j < steps_.size(); j++) {
+        for (size_t i = 0; i < j; i++) {
+            if (steps_[i].access.conflicts(steps_[j].access)) {
+                wave_of[j] = std::max(wave_of[j], wave_of[i] + 1);
+            }
+        }
+        if (wave_of[j] >= waves_.size()) {
+            waves_.resize(wave_of[j] + 1);
+        }
+        waves_[wave_of[j]].push_back(j);
+    }
+}
+
+void SystemScheduler::run_step(ScheduledStep& step, Blackboard& blackboard, entt::DefaultRegistry& registry) {
+    auto start = std::chrono::steady_clock::now();
+    step.step(blackboard, registry);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    step.ms += elapsed.count();
+}
+
+void SystemScheduler::run(Blackboard& blackboard, entt::DefaultRegistry& registry) {
+    if (waves_.empty() && !steps_.empty()) {
+        build_waves();
+    }
+    if (!pools_ready_) {
+        for (auto& step : steps_) {
+            step.access.assure(registry);
+        }
+        pools_ready_ = true;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (auto& wave : waves_) {
+        if (wave.size() == 1) {
+            run_step(steps_[wave[0]], blackboard, registry);
+            continue;
+        }
+
+        // the main thread takes the first step and helps with the rest while it waits,
+        // steps that split their own loops across the job system get helped the same way
+        JobSystem& jobs = JobSystem::instance();
+        JobSystem::Counter counter;
+        for (size_t i = 1; i < wave.size(); i++) {
+            ScheduledStep* step = &steps_[wave[i]];
+            jobs.run([this, step, &blackboard, &registry]() {
+                run_step(*step, blackboard, registry);
+            }, &counter);
+        }
+        run_step(steps_[wave[0]], blackboard, registry);
+        jobs.wait(counter);
+    }
+    // later steps of the scene and the next run see this run's creates and destroys
+    blackboard.commands.apply(registry);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    wall_ms_ += elapsed.count();
+    runs_++;
+}
+
+void SystemScheduler::print_report(const char* label) {
+    if (runs_ == 0) {
+        return;
+    }
+    double step_ms = 0;
+    for (size_t w = 0; w < waves_.size(); w++) {
+        for (auto index : waves_[w]) {
+            auto& step = steps_[index];
+            printf("systems: %s wave %zu %-28s %.3fms\n", label, w, step.name.c_str(), step.ms / runs_);
+            step_ms += step.ms;
+            step.ms = 0;
+        }
+    }
+    printf("systems: %s %zu steps in %zu waves over %zu frames, %.3fms per frame, %.2fx parallelism\n",
+           label, steps_.size(), waves_.size(), runs_, wall_ms_ / runs_, wall_ms_ > 0 ? step_ms / wall_ms_ : 1.0);
+    runs_ = 0;
+    wall_ms_ = 0;
+}
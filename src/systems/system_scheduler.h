@@ -0,0 +1,61 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#ifndef PANDAEXPRESS_SYSTEM_SCHEDULER_H
+#define PANDAEXPRESS_SYSTEM_SCHEDULER_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "system.h"
+
+// Runs a scene's systems in the order they were added, except that systems whose declared
+// access doesn't conflict run concurrently on the job system. Steps are grouped into
+// waves; a step goes in the wave after the last earlier step it conflicts with, so every
+// conflicting pair keeps its order and exclusive steps act as barriers.
+class SystemScheduler {
+public:
+    typedef std::function<void(Blackboard&, entt::DefaultRegistry&)> Step;
+
+    SystemScheduler();
+
+    void add_step(const std::string& name, Step step,
+                  SystemAccess access = SystemAccess::exclusive_access());
+
+    // systems with a plain update(blackboard, registry)
+    template<typename S>
+    void add_system(const std::string& name, S& system,
+                    SystemAccess access = SystemAccess::exclusive_access()) {
+        add_step(name, [&system](Blackboard& blackboard, entt::DefaultRegistry& registry) {
+            system.update(blackboard, registry);
+        }, access);
+    }
+
+    // runs every wave, then flushes the commands the steps recorded
+    void run(Blackboard& blackboard, entt::DefaultRegistry& registry);
+
+    // per step average time and how much of it overlapped, only if run since the last report
+    void print_report(const char* label);
+
+private:
+    struct ScheduledStep {
+        std::string name;
+        Step step;
+        SystemAccess access;
+        double ms; // since the last report
+    };
+
+    std::vector<ScheduledStep> steps_;
+    std::vector<std::vector<size_t>> waves_;
+    bool pools_ready_;
+    size_t runs_;
+    double wall_ms_;
+
+    void build_waves();
+
+    void run_step(ScheduledStep& step, Blackboard& blackboard, entt::DefaultRegistry& registry);
+};
+
+#endif //PANDAEXPRESS_SYSTEM_SCHEDULER_H
@@ -23,3 +23,7 @@ void TextTransformSystem::update(Blackboard &blackboard, entt::DefaultRegistry&
         text.set_scale(transform.x_scale); // y-scale is unused
     }
 }
+
+SystemAccess TextTransformSystem::access() const {
+    return SystemAccess().reads<Transform>().writes<Text>();
+}
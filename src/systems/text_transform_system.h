@@ -12,6 +12,8 @@ class TextTransformSystem : public System {
 public:
     TextTransformSystem();
     virtual void update(Blackboard& blackboard, entt::DefaultRegistry& registry) override;
+
+    SystemAccess access() const;
 };
 
 
@@ -9,6 +9,30 @@ void TimerSystem::update(Blackboard& blackboard, entt::DefaultRegistry& registry
     auto timers = registry.view<Timer>();
     for (auto entity : timers) {
         Timer& timer = timers.get(entity);
+        // scheduled before the tick, the delay is measured from where the wheel stands now
+        if (timer.has_unscheduled()) {
+            timer.schedule([this, entity](TimerLabel label, float delay) {
+                return wheel_.schedule(entity, label, delay);
+            });
+        }
         timer.update(blackboard.delta_time);
     }
-}
\ No newline at end of file
+
+    fired_.clear();
+    expired_.clear();
+    wheel_.advance(blackboard.delta_time, fired_);
+    for (auto& expiry : fired_) {
+        if (registry.valid(expiry.entity) && registry.has<Timer>(expiry.entity) &&
+            registry.get<Timer>(expiry.entity).is_scheduled(expiry.label, expiry.handle)) {
+            expired_.push_back(expiry);
+        }
+    }
+}
+
+SystemAccess TimerSystem::access() const {
+    return SystemAccess().writes<Timer>();
+}
+
+const std::vector<TimerWheel::Expiry>& TimerSystem::expired() const {
+    return expired_;
+}
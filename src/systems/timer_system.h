@@ -6,12 +6,29 @@
 #define PANDAEXPRESS_TIMER_SYSTEM_H
 
 
+#include <vector>
 #include <util/blackboard.h>
+#include <util/timer_wheel.h>
 #include <entt/entity/registry.hpp>
+#include <components/timer.h>
+#include "system.h"
 
+// Advances every Timer component and schedules their watches on one wheel per scene, so the
+// watches that run out are reported once instead of each system polling its own every frame
 class TimerSystem {
 public:
     void update(Blackboard& blackboard, entt::DefaultRegistry& registry);
+
+    SystemAccess access() const;
+
+    // watches on Timer components that ran out during the last update, in deadline order;
+    // ones removed, saved again or reset since they were scheduled are left out
+    const std::vector<TimerWheel::Expiry>& expired() const;
+
+private:
+    TimerWheel wheel_;
+    std::vector<TimerWheel::Expiry> fired_;
+    std::vector<TimerWheel::Expiry> expired_;
 };
 
 
@@ -0,0 +1,88 @@
+//
+// Created by agent on 19/10/26.
+//
+// Measures how the per-entity loops scale on the job system
+// usage: job_benchmark [entities] [grain]
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#include <entt/entity/registry.hpp>
+#include <components/transform.h>
+#include <components/velocity.h>
+#include <components/timer.h>
+#include <util/job_system.h>
+
+static const int FRAMES = 200;
+static const float DELTA_TIME = 1.f / 60.f;
+
+template<typename Loop>
+static double time_frames(Loop loop) {
+    loop(); // warm up caches and the persistent view
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < FRAMES; i++) {
+        loop();
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / FRAMES;
+}
+
+int main(int argc, char** argv) {
+    size_t entities = argc > 1 ? (size_t) atol(argv[1]) : 100000;
+    size_t grain = argc > 2 ? (size_t) atol(argv[2]) : 1024;
+
+    entt::DefaultRegistry registry;
+    for (size_t i = 0; i < entities; i++) {
+        auto entity = registry.create();
+        registry.assign<Transform>(entity, (float) i, 0.f, 0.f);
+        registry.assign<Velocity>(entity, 1.f, -1.f);
+        if (i % 4 == 0) {
+            auto& timer = registry.assign<Timer>(entity);
+            timer.save_watch(Timer::label("spit"), 2.3f);
+            timer.save_watch(Timer::label("fall"), 1.f);
+        }
+    }
+
+    // PhysicsSystem::apply_velocity
+    auto velocity_view = registry.view<Velocity, Transform>(entt::persistent_t{});
+    auto apply_velocity = [&velocity_view](entt::DefaultRegistry::entity_type entity) {
+        auto& transform = velocity_view.get<Transform>(entity);
+        auto& velocity = velocity_view.get<Velocity>(entity);
+        transform.x += velocity.x_velocity * DELTA_TIME;
+        transform.y += velocity.y_velocity * DELTA_TIME;
+    };
+    // TimerSystem::update
+    auto timer_view = registry.view<Timer>();
+    auto update_timer = [&timer_view](entt::DefaultRegistry::entity_type entity) {
+        timer_view.get(entity).update(DELTA_TIME);
+    };
+
+    double serial_velocity = time_frames([&] {
+        for (auto entity : velocity_view) {
+            apply_velocity(entity);
+        }
+    });
+    double serial_timer = time_frames([&] {
+        for (auto entity : timer_view) {
+            update_timer(entity);
+        }
+    });
+    printf("%zu entities, grain %zu, %d frames\n", entities, grain, FRAMES);
+    printf("threads  apply_velocity        timer_update\n");
+    printf("serial   %7.3fms          %7.3fms\n", serial_velocity, serial_timer);
+
+    // the calling thread works too, so a system with n workers runs on n + 1 threads
+    size_t hardware = std::max(2u, std::thread::hardware_concurrency());
+    for (size_t workers = 1; workers < hardware; workers *= 2) {
+        JobSystem jobs(workers);
+        double velocity_ms = time_frames([&] { jobs.parallel_each(velocity_view, grain, apply_velocity); });
+        double timer_ms = time_frames([&] { jobs.parallel_each(timer_view, grain, update_timer); });
+        printf("%-7zu  %7.3fms %5.2fx   %7.3fms %5.2fx\n", jobs.size(),
+               velocity_ms, serial_velocity / velocity_ms, timer_ms, serial_timer / timer_ms);
+    }
+    return 0;
+}
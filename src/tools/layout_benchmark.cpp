@@ -0,0 +1,230 @@
+//
+// Created by agent on 19/10/26.
+//
+// Measures the physics loops before and after co-sorting the Velocity, Transform and Collidable
+// pools and packing the static side of the collision sweep, with cache misses where perf allows
+// usage: layout_benchmark [bodies] [dynamic]
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <entt/entity/registry.hpp>
+#include <components/transform.h>
+#include <components/velocity.h>
+#include <components/collidable.h>
+
+static const int FRAMES = 200;
+static const float DELTA_TIME = 1.f / 60.f;
+
+// hardware cache misses of this thread, or -1 when perf events are unavailable (containers, paranoid kernels)
+class CacheMisses {
+public:
+    CacheMisses() : fd_(-1) {
+#ifdef __linux__
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = (int) syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+    }
+
+    ~CacheMisses() {
+#ifdef __linux__
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+#endif
+    }
+
+    void start() {
+#ifdef __linux__
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    long long stop() {
+        long long count = -1;
+#ifdef __linux__
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fd_, &count, sizeof(count)) != sizeof(count)) {
+                count = -1;
+            }
+        }
+#endif
+        return count;
+    }
+
+private:
+    int fd_;
+};
+
+struct Result {
+    double ms;
+    long long misses;
+};
+
+template<typename Loop>
+static Result time_frames(CacheMisses& counter, Loop loop) {
+    loop(); // warm up the persistent view
+    counter.start();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < FRAMES; i++) {
+        loop();
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    long long misses = counter.stop();
+    return {elapsed.count() / FRAMES, misses < 0 ? -1 : misses / FRAMES};
+}
+
+static void print_row(const char* name, Result before, Result after) {
+    printf("%-16s %8.3fms %8.3fms %6.2fx", name, before.ms, after.ms, before.ms / after.ms);
+    if (before.misses >= 0 && after.misses >= 0) {
+        printf("   %10lld %10lld misses/frame", before.misses, after.misses);
+    }
+    printf("\n");
+}
+
+// PhysicsSystem::check_collisions, the sweep of one dynamic body against every collidable
+static bool overlaps(const Collidable& dc, const Transform& dp, const Velocity& dv,
+                     const Collidable& sc, const Transform& sp, const Velocity& sv) {
+    float dx = dp.x + (dv.x_velocity - sv.x_velocity) * DELTA_TIME - sp.x;
+    float dy = dp.y + (dv.y_velocity - sv.y_velocity) * DELTA_TIME - sp.y;
+    return std::abs(dx) * 2 < dc.width + sc.width && std::abs(dy) * 2 < dc.height + sc.height;
+}
+
+struct Body {
+    uint32_t entity;
+    Collidable collider;
+    Transform position;
+    const Velocity* velocity;
+};
+
+int main(int argc, char** argv) {
+    size_t bodies = argc > 1 ? (size_t) atol(argv[1]) : 20000;
+    size_t dynamic = argc > 2 ? (size_t) atol(argv[2]) : 32;
+
+    // a level's worth of churn: platforms and enemies spawned chunk by chunk, a third of them
+    // despawned again, so the pools end up in unrelated orders the way a long run leaves them
+    entt::DefaultRegistry registry;
+    std::mt19937 rng(7);
+    std::vector<entt::DefaultRegistry::entity_type> entities;
+    for (size_t i = 0; i < bodies + bodies / 3; i++) {
+        auto entity = registry.create();
+        entities.push_back(entity);
+    }
+    std::shuffle(entities.begin(), entities.end(), rng);
+    for (size_t i = 0; i < entities.size(); i++) {
+        registry.assign<Transform>(entities[i], (float) (i % 1000) * 10.f, (float) (i / 1000) * 10.f, 0.f);
+    }
+    std::shuffle(entities.begin(), entities.end(), rng);
+    for (size_t i = 0; i < entities.size(); i++) {
+        registry.assign<Collidable>(entities[i], 10.f, 10.f);
+        if (i % 4 == 0) {
+            registry.assign<Velocity>(entities[i], 1.f, -1.f);
+        }
+    }
+    for (size_t i = 0; i < bodies / 3; i++) {
+        registry.destroy(entities[i]);
+    }
+
+    auto velocity_view = registry.view<Velocity, Transform>(entt::persistent_t{});
+    auto static_view = registry.view<Collidable, Transform>();
+    std::vector<entt::DefaultRegistry::entity_type> movers(velocity_view.begin(), velocity_view.end());
+    movers.resize(std::min(movers.size(), dynamic));
+
+    // PhysicsSystem::apply_velocity
+    auto apply_velocity = [&] {
+        for (auto entity : velocity_view) {
+            auto& transform = velocity_view.get<Transform>(entity);
+            auto& velocity = velocity_view.get<Velocity>(entity);
+            transform.x += velocity.x_velocity * DELTA_TIME;
+            transform.y += velocity.y_velocity * DELTA_TIME;
+        }
+    };
+    size_t hits = 0;
+    auto probe_sweep = [&] {
+        for (auto d_entity : movers) {
+            auto& dc = registry.get<Collidable>(d_entity);
+            auto& dp = registry.get<Transform>(d_entity);
+            auto& dv = registry.get<Velocity>(d_entity);
+            for (auto s_entity : static_view) {
+                if (s_entity == d_entity) {
+                    continue;
+                }
+                auto null_v = Velocity(0, 0);
+                auto& sv = null_v;
+                if (registry.has<Velocity>(s_entity)) {
+                    sv = registry.get<Velocity>(s_entity);
+                }
+                hits += overlaps(dc, dp, dv, static_view.get<Collidable>(s_entity),
+                                 static_view.get<Transform>(s_entity), sv);
+            }
+        }
+    };
+    std::vector<Body> packed;
+    auto packed_sweep = [&] {
+        packed.clear();
+        for (auto s_entity : static_view) {
+            const Velocity* velocity = registry.has<Velocity>(s_entity) ? &registry.get<Velocity>(s_entity) : nullptr;
+            packed.push_back({s_entity, static_view.get<Collidable>(s_entity), static_view.get<Transform>(s_entity),
+                              velocity});
+        }
+        auto null_v = Velocity(0, 0);
+        for (auto d_entity : movers) {
+            auto& dc = registry.get<Collidable>(d_entity);
+            auto& dp = registry.get<Transform>(d_entity);
+            auto& dv = registry.get<Velocity>(d_entity);
+            for (auto& body : packed) {
+                if (body.entity == d_entity) {
+                    continue;
+                }
+                hits += overlaps(dc, dp, dv, body.collider, body.position, body.velocity ? *body.velocity : null_v);
+            }
+        }
+    };
+
+    CacheMisses counter;
+    Result velocity_before = time_frames(counter, apply_velocity);
+    Result sweep_before = time_frames(counter, probe_sweep);
+
+    // PhysicsSystem::sort_pools
+    registry.sort<Transform, Velocity>();
+    registry.sort<Collidable, Transform>();
+    velocity_view.sort<Velocity>();
+
+    Result velocity_after = time_frames(counter, apply_velocity);
+    Result sweep_after = time_frames(counter, packed_sweep);
+
+    printf("%zu bodies, %zu moving, %zu swept per frame, %d frames, %zu overlaps\n",
+           registry.size<Collidable>(), velocity_view.size(), movers.size(), FRAMES, hits);
+    printf("loop             unsorted   co-sorted\n");
+    print_row("apply_velocity", velocity_before, velocity_after);
+    print_row("collision sweep", sweep_before, sweep_after);
+    if (velocity_before.misses < 0) {
+        printf("cache misses unavailable, perf_event_open was refused\n");
+    }
+    return 0;
+}
@@ -0,0 +1,114 @@
+//
+// Created by agent on 19/10/26.
+//
+// Offline tool that compiles level CSVs into a level pack the game can mmap
+// usage: level_compiler <output pack> <csv files...>
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <level/level_pack.h>
+#include <util/csv_reader.h>
+#include <util/hash.h>
+
+static bool read_file(const char* path, std::vector<unsigned char>& bytes) {
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    bytes.resize(size > 0 ? (size_t) size : 0);
+    bool ok = fread(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    fclose(file);
+    return ok;
+}
+
+static std::string file_name(const char* path) {
+    std::string name(path);
+    size_t slash = name.find_last_of("/\\");
+    return slash == std::string::npos ? name : name.substr(slash + 1);
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <output pack> <csv files...>\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<LevelPackEntry> entries;
+    std::vector<std::vector<char>> tiles;
+    std::vector<unsigned char> bytes;
+
+    for (int i = 2; i < argc; i++) {
+        std::string name = file_name(argv[i]);
+        if (name.size() >= LEVEL_PACK_NAME_LENGTH) {
+            fprintf(stderr, "skipping %s, name is too long\n", argv[i]);
+            continue;
+        }
+        if (!read_file(argv[i], bytes)) {
+            fprintf(stderr, "skipping %s, can't read it\n", argv[i]);
+            continue;
+        }
+
+        // parsed by the same reader the game falls back to, so both agree on every tile
+        auto rows = CSVReader(argv[i]).getData();
+        size_t width = 0;
+        for (auto& row : rows) {
+            width = std::max(width, row.size());
+        }
+        std::vector<char> level(width * rows.size(), '\0');
+        for (size_t y = 0; y < rows.size(); y++) {
+            std::copy(rows[y].begin(), rows[y].end(), level.begin() + y * width);
+        }
+
+        LevelPackEntry entry;
+        memset(&entry, 0, sizeof(entry));
+        strncpy(entry.file, name.c_str(), sizeof(entry.file) - 1);
+        entry.source_hash = hash_bytes(bytes.data(), bytes.size());
+        entry.width = (uint32_t) width;
+        entry.height = (uint32_t) rows.size();
+        entries.push_back(entry);
+        tiles.push_back(std::move(level));
+    }
+
+    LevelPackHeader header;
+    memcpy(header.magic, LEVEL_PACK_MAGIC, sizeof(header.magic));
+    header.version = LEVEL_PACK_VERSION;
+    header.count = (uint32_t) entries.size();
+    header.reserved = 0;
+
+    uint64_t offset = sizeof(header) + entries.size() * sizeof(LevelPackEntry);
+    for (size_t i = 0; i < entries.size(); i++) {
+        entries[i].offset = offset;
+        offset += tiles[i].size();
+    }
+
+    FILE* out = fopen(argv[1], "wb");
+    if (out == nullptr) {
+        fprintf(stderr, "can't open %s for writing\n", argv[1]);
+        return 1;
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, out) == 1;
+    if (!entries.empty()) {
+        ok = ok && fwrite(entries.data(), sizeof(LevelPackEntry), entries.size(), out) == entries.size();
+    }
+    for (size_t i = 0; ok && i < tiles.size(); i++) {
+        ok = tiles[i].empty() || fwrite(tiles[i].data(), 1, tiles[i].size(), out) == tiles[i].size();
+    }
+    long written = ftell(out);
+    fclose(out);
+
+    if (!ok) {
+        fprintf(stderr, "failed writing %s\n", argv[1]);
+        remove(argv[1]);
+        return 1;
+    }
+    printf("compiled %zu levels into %s (%ld bytes)\n", entries.size(), argv[1], written);
+    return 0;
+}
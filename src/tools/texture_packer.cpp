@@ -0,0 +1,122 @@
+//
+// Created by agent on 19/10/26.
+//
+// Offline tool that decodes PNGs into a texture pack the game can mmap
+// usage: texture_packer <output pack> <png files...>
+//
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#include <graphics/texture_pack.h>
+#include <util/hash.h>
+
+static bool read_file(const char* path, std::vector<unsigned char>& bytes) {
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    bytes.resize(size > 0 ? (size_t) size : 0);
+    bool ok = size > 0 && fread(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    fclose(file);
+    return ok;
+}
+
+static std::string file_name(const char* path) {
+    std::string name(path);
+    size_t slash = name.find_last_of("/\\");
+    return slash == std::string::npos ? name : name.substr(slash + 1);
+}
+
+static uint64_t align(uint64_t offset) {
+    return (offset + TEXTURE_PACK_ALIGNMENT - 1) / TEXTURE_PACK_ALIGNMENT * TEXTURE_PACK_ALIGNMENT;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <output pack> <png files...>\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<TexturePackEntry> entries;
+    std::vector<stbi_uc*> pixels;
+    std::vector<unsigned char> bytes;
+
+    for (int i = 2; i < argc; i++) {
+        std::string name = file_name(argv[i]);
+        if (name.size() >= TEXTURE_PACK_NAME_LENGTH) {
+            fprintf(stderr, "skipping %s, name is too long\n", argv[i]);
+            continue;
+        }
+        if (!read_file(argv[i], bytes)) {
+            fprintf(stderr, "skipping %s, can't read it\n", argv[i]);
+            continue;
+        }
+        int width, height;
+        stbi_uc* data = stbi_load_from_memory(bytes.data(), (int) bytes.size(), &width, &height, nullptr, 4);
+        if (data == nullptr) {
+            fprintf(stderr, "skipping %s, %s\n", argv[i], stbi_failure_reason());
+            continue;
+        }
+
+        TexturePackEntry entry;
+        memset(&entry, 0, sizeof(entry));
+        strncpy(entry.file, name.c_str(), sizeof(entry.file) - 1);
+        entry.source_hash = hash_bytes(bytes.data(), bytes.size());
+        entry.width = (uint32_t) width;
+        entry.height = (uint32_t) height;
+        entry.size = (uint64_t) width * height * 4;
+        entries.push_back(entry);
+        pixels.push_back(data);
+    }
+
+    TexturePackHeader header;
+    memcpy(header.magic, TEXTURE_PACK_MAGIC, sizeof(header.magic));
+    header.version = TEXTURE_PACK_VERSION;
+    header.count = (uint32_t) entries.size();
+    header.reserved = 0;
+
+    uint64_t offset = align(sizeof(header) + entries.size() * sizeof(TexturePackEntry));
+    for (auto& entry : entries) {
+        entry.offset = offset;
+        offset = align(offset + entry.size);
+    }
+
+    FILE* out = fopen(argv[1], "wb");
+    if (out == nullptr) {
+        fprintf(stderr, "can't open %s for writing\n", argv[1]);
+        return 1;
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, out) == 1;
+    if (!entries.empty()) {
+        ok = ok && fwrite(entries.data(), sizeof(TexturePackEntry), entries.size(), out) == entries.size();
+    }
+    for (size_t i = 0; ok && i < entries.size(); i++) {
+        // zero pad up to the page boundary
+        long position = ftell(out);
+        std::vector<unsigned char> padding((size_t) (entries[i].offset - position), 0);
+        ok = padding.empty() || fwrite(padding.data(), 1, padding.size(), out) == padding.size();
+        ok = ok && fwrite(pixels[i], 1, (size_t) entries[i].size, out) == entries[i].size;
+    }
+    long written = ftell(out);
+    fclose(out);
+
+    for (auto data : pixels) {
+        stbi_image_free(data);
+    }
+    if (!ok) {
+        fprintf(stderr, "failed writing %s\n", argv[1]);
+        remove(argv[1]);
+        return 1;
+    }
+    printf("packed %zu textures into %s (%ld bytes)\n", entries.size(), argv[1], written);
+    return 0;
+}
@@ -24,6 +24,12 @@
 #include "components/interactable.h"
 #include "components/health.h"
 
+static const TimerLabel BAT_ATTACK_LABEL = Timer::label("batAttack");
+static const TimerLabel BAT_SHOOTER_LABEL = Timer::label("batShooter");
+static const TimerLabel TELEPORT_LABEL = Timer::label("teleport");
+static const TimerLabel TELEPORT_DELAY_LABEL = Timer::label("teleportDelay");
+static const TimerLabel TELEPORT_INTO_FRAME_LABEL = Timer::label("teleportIntoFrame");
+
 class AINodes {
 public:
 
@@ -160,8 +166,8 @@ public:
                     return false;
                 }
 
-                if(timer.watch_exists("batAttack")) {
-                    if (timer.is_done("batAttack")) {
+                if(timer.watch_exists(BAT_ATTACK_LABEL)) {
+                    if (timer.is_done(BAT_ATTACK_LABEL)) {
                         if(!pathSet){
                             path = a_star_system.getProjectilePath(blackboard,registry);
                             pathSet=true;
@@ -170,9 +176,9 @@ public:
                         drac_velocity.x_velocity = 0;
                         drac_velocity.y_velocity = 0;
 
-                        if (timer.watch_exists("batShooter")) {
+                        if (timer.watch_exists(BAT_SHOOTER_LABEL)) {
 
-                            if (timer.is_done("batShooter")) {
+                            if (timer.is_done(BAT_SHOOTER_LABEL)) {
                                 if(batCount <8){
                                     auto panda_view = registry.view<Panda, Transform>();
                                     for (auto panda_entity:panda_view) {
@@ -181,9 +187,13 @@ public:
 
                                         auto bat_entity = registry.create();
 
-                                        auto texture = blackboard.texture_manager.get_texture("bat");
-                                        auto shader = blackboard.shader_manager.get_shader("sprite");
-                                        auto mesh = blackboard.mesh_manager.get_mesh("sprite");
+                                        constexpr ResourceName BAT_TEXTURE = resource_name("bat");
+                                        auto texture = blackboard.texture_manager.get_texture(
+                                                blackboard.texture_manager.handle(BAT_TEXTURE));
+                                        auto shader = blackboard.shader_manager.get_shader(
+                                                blackboard.shader_manager.handle(SPRITE_SHADER));
+                                        auto mesh = blackboard.mesh_manager.get_mesh(
+                                                blackboard.mesh_manager.handle(SPRITE_MESH));
 
                                         float scaleY = 50.0 / texture.height();
                                         float scaleX = 50.0 / texture.width();
@@ -196,13 +206,13 @@ public:
                                                                     texture.height() * scaleY);
                                         registry.assign<Seeks>(bat_entity, path);
                                         batCount++;
-                                        timer.save_watch("batShooter", 0.1f);
+                                        timer.save_watch(BAT_SHOOTER_LABEL, 0.1f);
                                         blackboard.soundManager.playSFX(SFX_BAT_SHOT);
                                 }
 
                                 }else{
-                                    timer.remove("batAttack");
-                                    timer.remove("batShooter");
+                                    timer.remove(BAT_ATTACK_LABEL);
+                                    timer.remove(BAT_SHOOTER_LABEL);
                                     drac_chases.chase_speed=120.f;
                                     dracula.shooter_count++;
                                     batCount=0;
@@ -212,13 +222,13 @@ public:
 
                             }
                         } else {
-                            timer.save_watch("batShooter", 1.f);
+                            timer.save_watch(BAT_SHOOTER_LABEL, 1.f);
                             blackboard.soundManager.playSFX(SFX_DRACULA_LAUGH);
 
                         }
                     }
                 }else {
-                    timer.save_watch("batAttack", 4.f);
+                    timer.save_watch(BAT_ATTACK_LABEL, 4.f);
                     return false;
                 }
 
@@ -255,14 +265,14 @@ public:
                             return false;
                         }
 
-                        if(timer.watch_exists("teleport")) {
-                            if (timer.is_done("teleport")) {
+                        if(timer.watch_exists(TELEPORT_LABEL)) {
+                            if (timer.is_done(TELEPORT_LABEL)) {
                                 sprite.set_color(0.1, 0.9, 0.f); // green
-                                if(timer.watch_exists("teleportDelay")) {
+                                if(timer.watch_exists(TELEPORT_DELAY_LABEL)) {
                                     drac_chases.chase_speed=0.f;
                                     drac_velocity.x_velocity=0.f;
                                     drac_velocity.y_velocity=0.f;
-                                    if (timer.is_done("teleportDelay")) {
+                                    if (timer.is_done(TELEPORT_DELAY_LABEL)) {
                                         auto panda_view = registry.view<Panda, Transform>();
                                         for(auto panda_entity: panda_view) {
                                             auto panda_transform = panda_view.get<Transform>(panda_entity);
@@ -298,8 +308,8 @@ public:
                                             drac_transform.x = teleport_coords.x;
                                             drac_transform.y = teleport_coords.y;
                                             drac_chases.chase_speed=teleport_chase_speed;
-                                            timer.remove("teleportDelay");
-                                            timer.remove("teleport");
+                                            timer.remove(TELEPORT_DELAY_LABEL);
+                                            timer.remove(TELEPORT_LABEL);
                                             dracula.shooter_count++;
                                             sprite.set_color(1.f, 1.f, 1.f);
                                             if(dracula.shooter_count>6){
@@ -313,7 +323,7 @@ public:
                                         return false;
                                     }
                                 }else{
-                                    timer.save_watch("teleportDelay", 0.5f);
+                                    timer.save_watch(TELEPORT_DELAY_LABEL, 0.5f);
                                     blackboard.soundManager.playSFX(SFX_TELEPORT);
                                     return false;
                                 }
@@ -321,7 +331,7 @@ public:
                             }
 
                         }else {
-                            timer.save_watch("teleport", 1.f);
+                            timer.save_watch(TELEPORT_LABEL, 1.f);
                             return false;
                         }
 
@@ -355,14 +365,14 @@ public:
                     return false;
                 }
 
-                if(timer.watch_exists("teleportIntoFrame")) {
-                    if (timer.is_done("teleportIntoFrame")) {
-                        if(timer.watch_exists("teleportDelay")) {
+                if(timer.watch_exists(TELEPORT_INTO_FRAME_LABEL)) {
+                    if (timer.is_done(TELEPORT_INTO_FRAME_LABEL)) {
+                        if(timer.watch_exists(TELEPORT_DELAY_LABEL)) {
                             drac_chases.chase_speed=0.f;
                             drac_velocity.x_velocity=0.f;
                             drac_velocity.y_velocity=0.f;
 
-                            if (timer.is_done("teleportDelay")) {
+                            if (timer.is_done(TELEPORT_DELAY_LABEL)) {
                                 auto panda_view = registry.view<Panda, Transform>();
                                 for(auto panda_entity: panda_view) {
                                     auto panda_transform = panda_view.get<Transform>(panda_entity);
@@ -383,8 +393,8 @@ public:
                                     drac_transform.x = teleport_coords.x;
                                     drac_transform.y = teleport_coords.y;
                                     drac_chases.chase_speed=120.f;
-                                    timer.remove("teleportDelay");
-                                    timer.remove("teleportIntoFrame");
+                                    timer.remove(TELEPORT_DELAY_LABEL);
+                                    timer.remove(TELEPORT_INTO_FRAME_LABEL);
 
                                     return false;
                                 }
@@ -393,14 +403,14 @@ public:
                                 return false;
                             }
                         }else{
-                            timer.save_watch("teleportDelay", 0.5f);
+                            timer.save_watch(TELEPORT_DELAY_LABEL, 0.5f);
                             return false;
                         }
 
                     }
 
                 }else {
-                    timer.save_watch("teleportIntoFrame", 1.f);
+                    timer.save_watch(TELEPORT_INTO_FRAME_LABEL, 1.f);
                     return false;
                 }
 
@@ -9,12 +9,14 @@
 
 #include "../graphics/camera.h"
 #include "../graphics/mesh_manager.h"
+#include "../graphics/post_process_chain.h"
 #include "../graphics/shader_manager.h"
 #include "../graphics/texture_manager.h"
 #include "../graphics/window.h"
 #include "../util/random.h"
 #include "../util/constants.h"
 #include "../util/sound_manager.h"
+#include "../util/command_buffer.h"
 
 
 // Struct containing all our singletons
@@ -30,9 +32,11 @@ struct Blackboard {
     Random randNumGenerator;
     SoundManager soundManager;
     FontManager fontManager;
-    std::unique_ptr<Shader> post_process_shader;
+    PostProcessChain post_process_chain;
     float score;
     int story_lives;
     int story_health;
     float time_multiplier;
+    // structural changes deferred to the next sync point of the scene being updated
+    CommandBuffer commands;
 };
\ No newline at end of file
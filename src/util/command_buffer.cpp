@@ -0,0 +1,109 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#include <algorithm>
+#include <cstdio>
+#include "command_buffer.h"
+
+CommandBuffer::CommandBuffer() :
+        flushes_(0),
+        applied_(0),
+        duplicates_(0),
+        peak_(0)
+{}
+
+void CommandBuffer::create(EntityFn init) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    creates_.push_back(std::move(init));
+}
+
+void CommandBuffer::destroy(entity_type entity) {
+    destroy(entity, nullptr);
+}
+
+void CommandBuffer::destroy(entity_type entity, EntityFn despawn) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    destroys_.push_back({entity, std::move(despawn)});
+    destroying_.insert(entity);
+}
+
+void CommandBuffer::record(Registry::component_type type, entity_type entity,
+                           std::function<void(Registry&)> apply) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    changes_.push_back({type, entity, std::move(apply)});
+}
+
+bool CommandBuffer::destroying(entity_type entity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return destroying_.count(entity) > 0;
+}
+
+bool CommandBuffer::empty() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return creates_.empty() && changes_.empty() && destroys_.empty();
+}
+
+void CommandBuffer::apply(Registry& registry) {
+    std::vector<EntityFn> creates;
+    std::vector<Change> changes;
+    std::vector<Destroy> destroys;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        creates.swap(creates_);
+        changes.swap(changes_);
+        destroys.swap(destroys_);
+        destroying_.clear();
+    }
+    size_t count = creates.size() + changes.size() + destroys.size();
+    if (count == 0) {
+        return;
+    }
+
+    for (auto& init : creates) {
+        init(registry, registry.create());
+    }
+
+    // stable so repeated changes to one component still apply in the order they were recorded
+    std::stable_sort(changes.begin(), changes.end(), [](const Change& a, const Change& b) {
+        return a.type != b.type ? a.type < b.type : a.entity < b.entity;
+    });
+    for (auto& change : changes) {
+        change.apply(registry);
+    }
+
+    // several systems may condemn the same entity in one frame, only the first request counts
+    std::stable_sort(destroys.begin(), destroys.end(), [](const Destroy& a, const Destroy& b) {
+        return a.entity < b.entity;
+    });
+    auto last = std::unique(destroys.begin(), destroys.end(), [](const Destroy& a, const Destroy& b) {
+        return a.entity == b.entity;
+    });
+    duplicates_ += destroys.end() - last;
+    for (auto it = destroys.begin(); it != last; it++) {
+        if (!registry.valid(it->entity)) {
+            continue;
+        }
+        if (it->despawn) {
+            it->despawn(registry, it->entity);
+        } else {
+            registry.destroy(it->entity);
+        }
+    }
+
+    flushes_++;
+    applied_ += count;
+    peak_ = std::max(peak_, count);
+}
+
+void CommandBuffer::print_stats() {
+    if (flushes_ == 0) {
+        return;
+    }
+    printf("commands: %zu applied over %zu flushes, peak %zu in one flush, %zu duplicate destroys\n",
+           applied_, flushes_, peak_, duplicates_);
+    flushes_ = 0;
+    applied_ = 0;
+    duplicates_ = 0;
+    peak_ = 0;
+}
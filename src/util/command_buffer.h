@@ -0,0 +1,90 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#ifndef PANDAEXPRESS_COMMAND_BUFFER_H
+#define PANDAEXPRESS_COMMAND_BUFFER_H
+
+#include <functional>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+#include <entt/entity/registry.hpp>
+
+// Structural changes (create, destroy, assign, remove) recorded while systems iterate views and
+// applied together at a sync point: the end of a scheduler run and the end of a scene update.
+// Until then the entities are untouched, so views stay valid and a system never has to break out
+// of a loop after destroying what it is iterating. Recording is safe from scheduler worker threads.
+class CommandBuffer {
+public:
+    using Registry = entt::DefaultRegistry;
+    using entity_type = Registry::entity_type;
+    // builds a freshly created entity, or tears one down in place of registry.destroy
+    using EntityFn = std::function<void(Registry&, entity_type)>;
+
+    CommandBuffer();
+
+    void create(EntityFn init);
+
+    void destroy(entity_type entity);
+
+    // destroys through despawn instead, e.g. to hand pooled entities back to their EntityPool
+    void destroy(entity_type entity, EntityFn despawn);
+
+    // replaces the component if the entity already has one, skipped if the entity is gone by then
+    template<typename Component>
+    void assign(entity_type entity, Component component) {
+        record(Registry::type<Component>(), entity, [entity, component](Registry& registry) {
+            if (registry.valid(entity)) {
+                registry.accommodate<Component>(entity, component);
+            }
+        });
+    }
+
+    template<typename Component>
+    void remove(entity_type entity) {
+        record(Registry::type<Component>(), entity, [entity](Registry& registry) {
+            if (registry.valid(entity) && registry.has<Component>(entity)) {
+                registry.remove<Component>(entity);
+            }
+        });
+    }
+
+    // true if the entity is already queued for destruction, so it can be skipped until the flush
+    bool destroying(entity_type entity);
+
+    bool empty();
+
+    // creates first, then assigns and removes grouped by component type, then destroys sorted by
+    // entity with duplicates dropped; commands recorded while applying wait for the next flush
+    void apply(Registry& registry);
+
+    void print_stats();
+
+private:
+    struct Change {
+        Registry::component_type type;
+        entity_type entity;
+        std::function<void(Registry&)> apply;
+    };
+
+    struct Destroy {
+        entity_type entity;
+        EntityFn despawn;
+    };
+
+    void record(Registry::component_type type, entity_type entity, std::function<void(Registry&)> apply);
+
+    std::mutex mutex_;
+    std::vector<EntityFn> creates_;
+    std::vector<Change> changes_;
+    std::vector<Destroy> destroys_;
+    std::unordered_set<entity_type> destroying_; // entities in destroys_, for destroying()
+
+    size_t flushes_;
+    size_t applied_;
+    size_t duplicates_;
+    size_t peak_;
+};
+
+#endif //PANDAEXPRESS_COMMAND_BUFFER_H
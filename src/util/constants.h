@@ -14,6 +14,18 @@
 #define levels_path(name) data_path "/levels/" name
 #define mesh_path(name) data_path "/meshes/" name
 #define fonts_path(name) data_path "/fonts/" name
+#define texture_pack_path data_path "/textures.pack"
+#define shader_cache_path data_path "/shader_cache"
+#define level_pack_path data_path "/levels.pack"
+
+// textures uploaded to the GPU per frame while async loading is still going
+#define TEXTURE_UPLOADS_PER_FRAME 4
+
+// entities per job when a per-entity loop is split across the job system
+#define PARALLEL_GRAIN 256
+
+// bytes of transient per-frame buffers before the frame arena falls back to the heap
+#define FRAME_ARENA_BYTES (4 * 1024 * 1024)
 
 typedef int SceneID;
 typedef int SFXID;
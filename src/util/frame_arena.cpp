@@ -0,0 +1,70 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <new>
+#include "frame_arena.h"
+#include "constants.h"
+
+FrameArena::FrameArena(size_t capacity) :
+        memory_(new char[capacity]),
+        capacity_(capacity),
+        offset_(0),
+        frames_(0),
+        high_water_(0),
+        overflows_(0),
+        overflow_bytes_(0)
+{}
+
+FrameArena& FrameArena::instance() {
+    static FrameArena arena(FRAME_ARENA_BYTES);
+    return arena;
+}
+
+void* FrameArena::allocate(size_t size, size_t alignment) {
+    // new[] aligns the block for any fundamental type, so aligning offsets is enough
+    size_t offset = offset_.load(std::memory_order_relaxed);
+    size_t start, end;
+    do {
+        start = (offset + alignment - 1) & ~(alignment - 1);
+        end = start + size;
+        if (end > capacity_) {
+            overflows_++;
+            overflow_bytes_ += size;
+            return ::operator new(size);
+        }
+    } while (!offset_.compare_exchange_weak(offset, end, std::memory_order_relaxed));
+    return memory_.get() + start;
+}
+
+void FrameArena::deallocate(void* pointer) {
+    if (!owns(pointer)) {
+        ::operator delete(pointer);
+    }
+}
+
+bool FrameArena::owns(const void* pointer) const {
+    auto byte = static_cast<const char*>(pointer);
+    return byte >= memory_.get() && byte < memory_.get() + capacity_;
+}
+
+void FrameArena::reset() {
+    high_water_ = std::max(high_water_, offset_.load(std::memory_order_relaxed));
+    offset_.store(0, std::memory_order_relaxed);
+    frames_++;
+}
+
+void FrameArena::print_stats() {
+    high_water_ = std::max(high_water_, offset_.load(std::memory_order_relaxed));
+    if (frames_ == 0) {
+        return;
+    }
+    printf("arena: %zu frames, peak %.1fKB of %.1fKB, %zu overflow allocations (%.1fKB) fell back to the heap\n",
+           frames_, high_water_ / 1024.f, capacity_ / 1024.f, overflows_.load(), overflow_bytes_.load() / 1024.f);
+    frames_ = 0;
+    high_water_ = 0;
+    overflows_ = 0;
+    overflow_bytes_ = 0;
+}
@@ -0,0 +1,93 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#ifndef PANDAEXPRESS_FRAME_ARENA_H
+#define PANDAEXPRESS_FRAME_ARENA_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+// Bump allocator for buffers that live no longer than one frame. Allocating is an atomic add,
+// freeing does nothing, and reset() at the top of the main loop releases everything at once.
+// Anything still holding arena memory after the reset reads garbage, so only locals of an
+// update or render call may use it. When a frame needs more than the arena holds the rest comes
+// from the heap and is counted as overflow, a hint to raise FRAME_ARENA_BYTES.
+class FrameArena {
+public:
+    explicit FrameArena(size_t capacity);
+
+    static FrameArena& instance();
+
+    void* allocate(size_t size, size_t alignment);
+
+    // only overflow allocations are returned to the heap, arena memory waits for reset()
+    void deallocate(void* pointer);
+
+    void reset();
+
+    // peak bytes used in a frame and the heap fallbacks since the last print
+    void print_stats();
+
+private:
+    bool owns(const void* pointer) const;
+
+    std::unique_ptr<char[]> memory_;
+    size_t capacity_;
+    std::atomic<size_t> offset_;
+
+    size_t frames_;
+    size_t high_water_;
+    std::atomic<size_t> overflows_;
+    std::atomic<size_t> overflow_bytes_;
+};
+
+// STL adapter, containers built with it allocate from the frame arena
+template<typename T>
+class FrameAllocator {
+public:
+    typedef T value_type;
+
+    FrameAllocator() : arena_(&FrameArena::instance()) {}
+
+    explicit FrameAllocator(FrameArena& arena) : arena_(&arena) {}
+
+    template<typename U>
+    FrameAllocator(const FrameAllocator<U>& other) : arena_(other.arena_) {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(arena_->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* pointer, size_t) {
+        arena_->deallocate(pointer);
+    }
+
+    template<typename U>
+    bool operator==(const FrameAllocator<U>& other) const {
+        return arena_ == other.arena_;
+    }
+
+    template<typename U>
+    bool operator!=(const FrameAllocator<U>& other) const {
+        return arena_ != other.arena_;
+    }
+
+private:
+    template<typename U>
+    friend class FrameAllocator;
+
+    FrameArena* arena_;
+};
+
+template<typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+template<typename T, typename Hash = std::hash<T>, typename Equal = std::equal_to<T>>
+using FrameUnorderedSet = std::unordered_set<T, Hash, Equal, FrameAllocator<T>>;
+
+#endif //PANDAEXPRESS_FRAME_ARENA_H
@@ -0,0 +1,28 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#include <algorithm>
+#include <cstdio>
+#include "frame_stats.h"
+
+void FrameStats::record(float ms) {
+    frames_.push_back(ms);
+}
+
+void FrameStats::print(const char* label, int id) {
+    if (frames_.empty()) {
+        return;
+    }
+    std::vector<float> sorted(frames_);
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&sorted](float p) {
+        return sorted[std::min(sorted.size() - 1, (size_t) (p * sorted.size()))];
+    };
+    printf("frames: %s %d, %zu frames, p50 %.2fms, p99 %.2fms, max %.2fms\n",
+           label, id, sorted.size(), percentile(0.5f), percentile(0.99f), sorted.back());
+}
+
+void FrameStats::reset() {
+    frames_.clear();
+}
@@ -0,0 +1,24 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#ifndef PANDAEXPRESS_FRAME_STATS_H
+#define PANDAEXPRESS_FRAME_STATS_H
+
+#include <vector>
+
+// Collects frame times so hitches show up in the tail percentiles rather than the average
+class FrameStats {
+public:
+    void record(float ms);
+
+    // prints p50, p99 and max for the frames recorded since the last reset, if any
+    void print(const char* label, int id);
+
+    void reset();
+
+private:
+    std::vector<float> frames_;
+};
+
+#endif //PANDAEXPRESS_FRAME_STATS_H
@@ -0,0 +1,25 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#ifndef PANDAEXPRESS_HASH_H
+#define PANDAEXPRESS_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+
+static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+// 64 bit FNV-1a, pass a previous result as seed to hash several buffers as one
+inline uint64_t hash_bytes(const void* data, size_t size, uint64_t seed = FNV_OFFSET_BASIS) {
+    auto bytes = (const unsigned char*) data;
+    uint64_t hash = seed;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+#endif //PANDAEXPRESS_HASH_H
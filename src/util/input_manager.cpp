@@ -3,6 +3,7 @@
 //
 
 #include <SDL.h>
+#include <algorithm>
 
 #include "input_manager.h"
 
@@ -13,9 +14,11 @@ InputManager::InputManager() :
 {}
 
 void InputManager::update() {
-    SDL_Event event;
+    update(SDL_GetKeyboardState(NULL));
+}
 
-    auto* keystate = SDL_GetKeyboardState(NULL);
+void InputManager::update(const Uint8* keystate) {
+    SDL_Event event;
 
     // update tracked states
     for (auto& entry : key_states_) {
@@ -47,6 +50,15 @@ void InputManager::update() {
     }
 }
 
+std::vector<SDL_Scancode> InputManager::tracked_keys() const {
+    std::vector<SDL_Scancode> keys;
+    for (auto& entry : key_states_) {
+        keys.push_back(entry.first);
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
 bool InputManager::should_exit() {
     return should_exit_;
 }
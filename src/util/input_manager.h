@@ -6,6 +6,7 @@
 
 #include <SDL.h>
 #include <unordered_map>
+#include <vector>
 
 
 enum KeyStatus {
@@ -27,6 +28,13 @@ public:
     // update
     void update();
 
+    // updates from the given keyboard state instead of SDL's, used to replay recorded input
+    // keystate is indexed by scancode like SDL_GetKeyboardState
+    void update(const Uint8* keystate);
+
+    // tracked keys in scancode order
+    std::vector<SDL_Scancode> tracked_keys() const;
+
     // returns true if an exit event has been polled
     bool should_exit();
 
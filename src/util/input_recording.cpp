@@ -0,0 +1,140 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#include <cstring>
+#include "input_recording.h"
+
+InputRecorder::InputRecorder() : file_(nullptr), frames_(0) {
+}
+
+InputRecorder::~InputRecorder() {
+    close();
+}
+
+bool InputRecorder::open(const char* path, uint32_t seed, const std::vector<SDL_Scancode>& keys) {
+    close();
+    if (keys.size() > MAX_RECORDED_KEYS) {
+        fprintf(stderr, "recording: %zu keys don't fit a frame\n", keys.size());
+        return false;
+    }
+    file_ = fopen(path, "wb");
+    if (file_ == nullptr) {
+        fprintf(stderr, "recording: can't write %s\n", path);
+        return false;
+    }
+    keys_ = keys;
+    frames_ = 0;
+
+    InputRecordingHeader header = {{'P', 'X', 'I', 'R'}, INPUT_RECORDING_VERSION, seed, (uint32_t) keys.size()};
+    std::vector<uint16_t> scancodes(keys.begin(), keys.end());
+    bool ok = fwrite(&header, sizeof(header), 1, file_) == 1;
+    ok = ok && (scancodes.empty() ||
+                fwrite(scancodes.data(), sizeof(uint16_t), scancodes.size(), file_) == scancodes.size());
+    if (!ok) {
+        fprintf(stderr, "recording: can't write %s\n", path);
+        close();
+    }
+    return ok;
+}
+
+uint32_t InputRecorder::pack(const Uint8* keyboard) const {
+    uint32_t pressed = 0;
+    for (size_t i = 0; i < keys_.size(); i++) {
+        if (keyboard[keys_[i]]) {
+            pressed |= 1u << i;
+        }
+    }
+    return pressed;
+}
+
+void InputRecorder::record(float delta_time, uint32_t pressed, uint32_t state_hash) {
+    if (file_ == nullptr) {
+        return;
+    }
+    InputFrame frame = {delta_time, pressed, state_hash};
+    if (fwrite(&frame, sizeof(frame), 1, file_) != 1) {
+        fprintf(stderr, "recording: write failed, stopped after %zu frames\n", frames_);
+        close();
+        return;
+    }
+    frames_++;
+}
+
+void InputRecorder::close() {
+    if (file_ != nullptr) {
+        fclose(file_);
+        file_ = nullptr;
+        printf("recording: %zu frames\n", frames_);
+    }
+}
+
+InputReplay::InputReplay() : open_(false), seed_(0), keyboard_(SDL_NUM_SCANCODES, 0), frame_(0), diverged_at_(0) {
+}
+
+bool InputReplay::open(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr) {
+        fprintf(stderr, "replay: can't read %s\n", path);
+        return false;
+    }
+    InputRecordingHeader header;
+    bool ok = fread(&header, sizeof(header), 1, file) == 1 &&
+              memcmp(header.magic, "PXIR", 4) == 0 &&
+              header.version == INPUT_RECORDING_VERSION &&
+              header.keys <= MAX_RECORDED_KEYS;
+    std::vector<uint16_t> scancodes(ok ? header.keys : 0);
+    ok = ok && (scancodes.empty() || fread(scancodes.data(), sizeof(uint16_t), scancodes.size(), file) == scancodes.size());
+    InputFrame frame;
+    while (ok && fread(&frame, sizeof(frame), 1, file) == 1) {
+        frames_.push_back(frame);
+    }
+    fclose(file);
+    if (!ok) {
+        fprintf(stderr, "replay: %s is not an input recording\n", path);
+        frames_.clear();
+        return false;
+    }
+
+    seed_ = header.seed;
+    keys_.clear();
+    for (auto scancode : scancodes) {
+        keys_.push_back((SDL_Scancode) scancode);
+    }
+    frame_ = 0;
+    diverged_at_ = 0;
+    open_ = true;
+    printf("replay: %zu frames from %s\n", frames_.size(), path);
+    return true;
+}
+
+bool InputReplay::next() {
+    if (frame_ >= frames_.size()) {
+        return false;
+    }
+    uint32_t pressed = frames_[frame_].pressed;
+    for (size_t i = 0; i < keys_.size(); i++) {
+        keyboard_[keys_[i]] = (Uint8) ((pressed >> i) & 1u);
+    }
+    frame_++;
+    return true;
+}
+
+float InputReplay::delta_time() const {
+    return frames_[frame_ - 1].delta_time;
+}
+
+void InputReplay::check(uint32_t state_hash) {
+    if (diverged_at_ == 0 && frames_[frame_ - 1].state_hash != state_hash) {
+        diverged_at_ = frame_;
+        fprintf(stderr, "replay: diverged from the recording at frame %zu\n", frame_);
+    }
+}
+
+void InputReplay::print_report() const {
+    if (diverged_at_ == 0) {
+        printf("replay: %zu of %zu frames matched the recording\n", frame_, frames_.size());
+    } else {
+        printf("replay: diverged at frame %zu of %zu\n", diverged_at_, frames_.size());
+    }
+}
@@ -0,0 +1,93 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#ifndef PANDAEXPRESS_INPUT_RECORDING_H
+#define PANDAEXPRESS_INPUT_RECORDING_H
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include <SDL.h>
+
+// File layout: header, header.keys scancodes as uint16_t, then one InputFrame per simulated frame
+struct InputRecordingHeader {
+    char magic[4]; // "PXIR"
+    uint32_t version;
+    uint32_t seed; // passed to srand and the blackboard rng before anything draws from them
+    uint32_t keys;
+};
+
+struct InputFrame {
+    float delta_time; // before the time multiplier is applied
+    uint32_t pressed; // bit i is set if the header's key i was down
+    uint32_t state_hash; // simulation state after the frame, to find where a replay diverges
+};
+
+static const uint32_t INPUT_RECORDING_VERSION = 1;
+static const size_t MAX_RECORDED_KEYS = 32;
+
+// Writes the seed, key states and delta time of every frame so a run can be replayed exactly
+class InputRecorder {
+public:
+    InputRecorder();
+    ~InputRecorder();
+
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+
+    // returns false if the file can't be written or there are more keys than fit a frame
+    bool open(const char* path, uint32_t seed, const std::vector<SDL_Scancode>& keys);
+
+    bool is_open() const { return file_ != nullptr; }
+
+    // packs the recorded keys' states, read it before the input manager polls events
+    uint32_t pack(const Uint8* keyboard) const;
+
+    void record(float delta_time, uint32_t pressed, uint32_t state_hash);
+
+    void close();
+
+private:
+    FILE* file_;
+    std::vector<SDL_Scancode> keys_;
+    size_t frames_;
+};
+
+// Plays a recording back frame by frame in place of the keyboard and the window's clock
+class InputReplay {
+public:
+    InputReplay();
+
+    // reads the whole recording, returns false if it's missing or not a recording
+    bool open(const char* path);
+
+    bool is_open() const { return open_; }
+
+    uint32_t seed() const { return seed_; }
+
+    // advances to the next frame, returns false once the recording has run out
+    bool next();
+
+    float delta_time() const;
+
+    // keyboard state in the layout of SDL_GetKeyboardState for the current frame
+    const Uint8* keyboard() const { return keyboard_.data(); }
+
+    // compares against the recorded state, reports the first frame that doesn't match
+    void check(uint32_t state_hash);
+
+    // prints whether the replay matched the recording
+    void print_report() const;
+
+private:
+    bool open_;
+    uint32_t seed_;
+    std::vector<SDL_Scancode> keys_;
+    std::vector<InputFrame> frames_;
+    std::vector<Uint8> keyboard_;
+    size_t frame_; // one past the current frame
+    size_t diverged_at_; // 0 if every checked frame matched
+};
+
+#endif //PANDAEXPRESS_INPUT_RECORDING_H
@@ -0,0 +1,241 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#include "job_system.h"
+
+namespace {
+    thread_local const JobSystem* tls_system = nullptr;
+    thread_local int tls_index = -1;
+
+    // failed looks for work before an idle worker sleeps
+    const int IDLE_SPINS = 64;
+}
+
+JobSystem::Deque::Deque() : top_(0), bottom_(0) {
+    for (auto& slot : slots_) {
+        slot.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+bool JobSystem::Deque::push(Job* job) {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_acquire);
+    if (bottom - top >= CAPACITY) {
+        return false;
+    }
+    slots_[bottom & (CAPACITY - 1)].store(job, std::memory_order_relaxed);
+    bottom_.store(bottom + 1, std::memory_order_release);
+    return true;
+}
+
+JobSystem::Job* JobSystem::Deque::pop() {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(bottom, std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_seq_cst);
+    if (top > bottom) {
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    Job* job = slots_[bottom & (CAPACITY - 1)].load(std::memory_order_relaxed);
+    if (top == bottom) {
+        // last job, race the thieves for it
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            job = nullptr;
+        }
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+JobSystem::Job* JobSystem::Deque::steal() {
+    int64_t top = top_.load(std::memory_order_seq_cst);
+    int64_t bottom = bottom_.load(std::memory_order_seq_cst);
+    if (top >= bottom) {
+        return nullptr;
+    }
+    Job* job = slots_[top & (CAPACITY - 1)].load(std::memory_order_relaxed);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    return job;
+}
+
+JobSystem::JobSystem(size_t threads) : sleeping_(0), wakeups_(0), stopping_(false) {
+    if (threads == 0) {
+        // a worker on a single core only takes time slices from the main thread
+        unsigned int hardware = std::thread::hardware_concurrency();
+        threads = hardware > 1 ? hardware - 1 : 0;
+    }
+    for (size_t i = 0; i <= threads; i++) {
+        deques_.emplace_back(new Deque());
+    }
+    tls_system = this;
+    tls_index = 0;
+    for (size_t i = 1; i <= threads; i++) {
+        threads_.emplace_back(&JobSystem::worker, this, (int) i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+    if (tls_system == this) {
+        tls_system = nullptr;
+        tls_index = -1;
+    }
+}
+
+JobSystem& JobSystem::instance() {
+    static JobSystem system;
+    return system;
+}
+
+size_t JobSystem::size() const {
+    return deques_.size();
+}
+
+int JobSystem::thread_index() const {
+    return tls_system == this ? tls_index : -1;
+}
+
+void JobSystem::run(std::function<void()> fn, Counter* counter) {
+    Job* job = new Job{std::move(fn), counter};
+    if (counter != nullptr) {
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (threads_.empty()) {
+        execute(job);
+        return;
+    }
+    int self = thread_index();
+    if (self >= 0) {
+        if (!deques_[self]->push(job)) {
+            assert(false && "job deque full");
+            execute(job);
+            return;
+        }
+    } else {
+        std::lock_guard<std::mutex> lock(inject_mutex_);
+        injected_.push_back(job);
+    }
+    wake_one();
+}
+
+void JobSystem::wake_one() {
+    // pairs with the worker announcing its sleep before it looks for jobs one last time:
+    // either it finds the job just queued, or this sees it sleeping
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_seq_cst) == 0) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        if (wakeups_ >= sleeping_.load(std::memory_order_relaxed)) {
+            return;
+        }
+        wakeups_++;
+    }
+    wake_.notify_one();
+}
+
+void JobSystem::run_after(Counter& before, std::function<void()> fn, Counter* counter) {
+    run([this, &before, fn]() {
+        wait(before);
+        fn();
+    }, counter);
+}
+
+void JobSystem::wait(Counter& counter) {
+    int self = thread_index();
+    while (!counter.done()) {
+        Job* job = find_job(self);
+        if (job != nullptr) {
+            execute(job);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+JobSystem::Job* JobSystem::find_job(int self) {
+    if (self >= 0) {
+        Job* job = deques_[self]->pop();
+        if (job != nullptr) {
+            return job;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(inject_mutex_);
+        if (!injected_.empty()) {
+            Job* job = injected_.front();
+            injected_.pop_front();
+            return job;
+        }
+    }
+    // start stealing after our own deque so victims are spread out
+    size_t count = deques_.size();
+    size_t start = self >= 0 ? (size_t) self + 1 : 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t victim = (start + i) % count;
+        if ((int) victim == self) {
+            continue;
+        }
+        Job* job = deques_[victim]->steal();
+        if (job != nullptr) {
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+void JobSystem::execute(Job* job) {
+    job->fn();
+    if (job->counter != nullptr) {
+        job->counter->pending.fetch_sub(1, std::memory_order_release);
+    }
+    delete job;
+}
+
+void JobSystem::worker(int index) {
+    tls_system = this;
+    tls_index = index;
+    int idle = 0;
+    while (!stopping_.load(std::memory_order_acquire)) {
+        Job* job = find_job(index);
+        if (job != nullptr) {
+            execute(job);
+            idle = 0;
+            continue;
+        }
+        if (++idle < IDLE_SPINS) {
+            std::this_thread::yield();
+            continue;
+        }
+        // announce the sleep before looking once more, so a job pushed by a thread that didn't
+        // see this worker sleeping yet isn't left behind until the next push
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        sleeping_.fetch_add(1, std::memory_order_seq_cst);
+        job = find_job(index);
+        if (job == nullptr) {
+            wake_.wait(lock, [this]() {
+                return wakeups_ > 0 || stopping_.load(std::memory_order_acquire);
+            });
+            if (wakeups_ > 0) {
+                wakeups_--;
+            }
+        }
+        sleeping_.fetch_sub(1, std::memory_order_relaxed);
+        lock.unlock();
+        if (job != nullptr) {
+            execute(job);
+        }
+        idle = 0;
+    }
+}
@@ -0,0 +1,138 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#ifndef PANDAEXPRESS_JOB_SYSTEM_H
+#define PANDAEXPRESS_JOB_SYSTEM_H
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing job system for short frame-bound jobs. Every worker and the thread that created
+// the system own a lock-free deque: they push and pop their own jobs at the bottom, idle threads
+// steal from the top of the others. Waiting on a counter runs other jobs instead of blocking,
+// so jobs may wait on jobs they spawned. Long background work (decoding, chunk preparation)
+// belongs on a WorkerPool instead; like those jobs, these must not touch OpenGL.
+class JobSystem {
+public:
+    // jobs left in a batch, jobs that depend on the batch wait on it
+    struct Counter {
+        std::atomic<size_t> pending;
+
+        Counter() : pending(0) {}
+
+        bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+    };
+
+    // 0 threads picks one less than the hardware concurrency, the calling thread is the extra one;
+    // on a single core no workers are started and run() executes jobs inline
+    explicit JobSystem(size_t threads = 0);
+
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // shared by the game, the first call has to come from the main thread
+    static JobSystem& instance();
+
+    // threads running jobs, the owning thread included
+    size_t size() const;
+
+    void run(std::function<void()> fn, Counter* counter = nullptr);
+
+    // runs fn once every job counted by before has finished
+    void run_after(Counter& before, std::function<void()> fn, Counter* counter = nullptr);
+
+    // runs queued jobs until the counter reaches zero
+    void wait(Counter& counter);
+
+    // calls fn(begin, end) over [0, count) in chunks of grain, the caller takes the first chunk
+    template<typename Fn>
+    void parallel_for(size_t count, size_t grain, Fn fn) {
+        grain = std::max<size_t>(grain, 1);
+        if (count <= grain || size() == 1) {
+            fn((size_t) 0, count);
+            return;
+        }
+        Counter counter;
+        for (size_t begin = grain; begin < count; begin += grain) {
+            size_t end = std::min(count, begin + grain);
+            run([&fn, begin, end]() { fn(begin, end); }, &counter);
+        }
+        fn((size_t) 0, grain);
+        wait(counter);
+    }
+
+    // calls fn(entity) for every entity of a view with contiguous entities (persistent views and
+    // single component views), fn may only touch the components of the entity it's given
+    template<typename View, typename Fn>
+    void parallel_each(View& view, size_t grain, Fn fn) {
+        auto entities = view.data();
+        parallel_for(view.size(), grain, [entities, &fn](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                fn(entities[i]);
+            }
+        });
+    }
+
+private:
+    struct Job {
+        std::function<void()> fn;
+        Counter* counter;
+    };
+
+    // Chase-Lev deque of fixed capacity. A frame's jobs stay far below it, run() asserts when one
+    // fills up and executes the job inline in release builds
+    class Deque {
+    public:
+        Deque();
+
+        // owner only
+        bool push(Job* job);
+
+        // owner only, newest first
+        Job* pop();
+
+        // any thread, oldest first
+        Job* steal();
+
+    private:
+        static const int64_t CAPACITY = 4096;
+        std::atomic<int64_t> top_;
+        std::atomic<int64_t> bottom_;
+        std::atomic<Job*> slots_[CAPACITY];
+    };
+
+    std::vector<std::unique_ptr<Deque>> deques_; // 0 belongs to the owning thread
+    std::vector<std::thread> threads_;
+    std::mutex inject_mutex_; // jobs run from threads without a deque
+    std::deque<Job*> injected_;
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    std::atomic<size_t> sleeping_; // only changed with sleep_mutex_ held
+    size_t wakeups_; // sent to sleeping workers and not taken yet, guarded by sleep_mutex_
+    std::atomic<bool> stopping_;
+
+    // index of the calling thread's deque, or -1 for threads that don't belong to this system
+    int thread_index() const;
+
+    Job* find_job(int self);
+
+    void execute(Job* job);
+
+    // hands a sleeping worker the job that was just queued
+    void wake_one();
+
+    void worker(int index);
+};
+
+#endif //PANDAEXPRESS_JOB_SYSTEM_H
@@ -0,0 +1,42 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#ifndef PANDAEXPRESS_MAPPED_FILE_H
+#define PANDAEXPRESS_MAPPED_FILE_H
+
+#include <cstddef>
+
+// Owning read-only memory mapping of a whole file
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // maps the file, closing any previous mapping; returns false if it can't be opened
+    bool open(const char* path);
+
+    void close();
+
+    bool is_open() const { return data_ != nullptr; }
+
+    const unsigned char* data() const { return data_; }
+
+    size_t size() const { return size_; }
+
+private:
+    const unsigned char* data_;
+    size_t size_;
+#ifdef _WIN32
+    void* file_;
+    void* mapping_;
+#else
+    int fd_;
+#endif
+};
+
+
+#endif //PANDAEXPRESS_MAPPED_FILE_H
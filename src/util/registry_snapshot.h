@@ -0,0 +1,120 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#ifndef PANDAEXPRESS_REGISTRY_SNAPSHOT_H
+#define PANDAEXPRESS_REGISTRY_SNAPSHOT_H
+
+#include <cassert>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <entt/entity/registry.hpp>
+
+// A copy of a handful of entities and the listed components they have, kept in one array per
+// component type. capture() goes through entt's snapshot; restore() is done here because entt's
+// loaders want an empty registry and default constructible components, and a scene's registry
+// holds pooled entities and renderables that are neither. Restoring creates fresh entities and
+// copies each array in one pass, the rest of the registry is left alone.
+template<typename... Component>
+class RegistrySnapshot {
+public:
+    using Registry = entt::DefaultRegistry;
+    using entity_type = Registry::entity_type;
+
+    template<typename It>
+    void capture(const Registry &registry, It first, It last) {
+        clear();
+        entities_.assign(first, last);
+        index_.reserve(entities_.size());
+        for (size_t i = 0; i < entities_.size(); i++) {
+            index_.emplace(entities_[i], i);
+        }
+        Archive archive{*this};
+        registry.snapshot().component<Component...>(archive, entities_.cbegin(), entities_.cend());
+    }
+
+    // creates an entity for every captured one and copies the captured components onto it,
+    // entities from an earlier restore are not touched
+    void restore(Registry &registry) {
+        restored_.resize(entities_.size());
+        for (auto &entity : restored_) {
+            entity = registry.create();
+        }
+        using accumulator_type = int[];
+        accumulator_type accumulator = {0, (restore_pool<Component>(registry), 0)...};
+        (void) accumulator;
+    }
+
+    // the entity the last restore() made in place of a captured one
+    entity_type restored(entity_type captured) const {
+        auto it = index_.find(captured);
+        assert(it != index_.end() && restored_.size() == entities_.size());
+        return restored_[it->second];
+    }
+
+    bool empty() const {
+        return entities_.empty();
+    }
+
+    size_t size() const {
+        return entities_.size();
+    }
+
+    // memory the captured components take up
+    size_t bytes() const {
+        size_t bytes = 0;
+        using accumulator_type = int[];
+        accumulator_type accumulator = {0, (bytes += pool_bytes<Component>(), 0)...};
+        (void) accumulator;
+        return bytes;
+    }
+
+    void clear() {
+        entities_.clear();
+        index_.clear();
+        restored_.clear();
+        using accumulator_type = int[];
+        accumulator_type accumulator = {0, (std::get<Pool<Component>>(pools_).clear(), 0)...};
+        (void) accumulator;
+    }
+
+private:
+    template<typename C>
+    using Pool = std::vector<std::pair<entity_type, C>>;
+
+    // what entt's snapshot writes to: a count before each component type, which the pools don't
+    // need, then every entity that has the component with its value
+    struct Archive {
+        RegistrySnapshot &snapshot;
+
+        void operator()(entity_type) {}
+
+        template<typename C>
+        void operator()(entity_type entity, const C &component) {
+            std::get<Pool<C>>(snapshot.pools_).emplace_back(entity, component);
+        }
+    };
+
+    template<typename C>
+    void restore_pool(Registry &registry) {
+        auto &pool = std::get<Pool<C>>(pools_);
+        registry.reserve<C>(registry.size<C>() + pool.size());
+        for (auto &item : pool) {
+            registry.assign<C>(restored(item.first), item.second);
+        }
+    }
+
+    template<typename C>
+    size_t pool_bytes() const {
+        return std::get<Pool<C>>(pools_).size() * sizeof(typename Pool<C>::value_type);
+    }
+
+    std::vector<entity_type> entities_;
+    std::unordered_map<entity_type, size_t> index_; // captured entity to its place in entities_
+    std::vector<entity_type> restored_;
+    std::tuple<Pool<Component>...> pools_;
+};
+
+#endif //PANDAEXPRESS_REGISTRY_SNAPSHOT_H
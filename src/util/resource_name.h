@@ -0,0 +1,76 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#ifndef PANDAEXPRESS_RESOURCE_NAME_H
+#define PANDAEXPRESS_RESOURCE_NAME_H
+
+#include <cstdint>
+#include <cstdio>
+#include <unordered_map>
+#include <vector>
+#include "hash.h"
+
+// Resources get an integer handle from their manager when they're loaded, fetching one by
+// handle is an array index. Names are interned at compile time as constexpr ResourceNames,
+// so finding the handle for a name hashes an integer instead of building a std::string.
+
+typedef uint32_t ResourceHandle;
+static const ResourceHandle INVALID_RESOURCE_HANDLE = UINT32_MAX;
+
+// same hash as hash_bytes over the name's characters
+constexpr uint64_t intern_hash(const char* name) {
+    uint64_t hash = FNV_OFFSET_BASIS;
+    for (; *name != '\0'; name++) {
+        hash ^= (unsigned char) *name;
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+struct ResourceName {
+    uint64_t hash;
+    const char* name;
+};
+
+constexpr ResourceName resource_name(const char* name) {
+    return ResourceName{intern_hash(name), name};
+}
+
+// names used on hot paths
+constexpr ResourceName SPRITE_SHADER = resource_name("sprite");
+constexpr ResourceName TEXT_SHADER = resource_name("text");
+constexpr ResourceName SPRITE_MESH = resource_name("sprite");
+
+// Handles of resources a manager stores elsewhere, pointers must stay valid as it grows
+template<typename Resource>
+class HandleTable {
+private:
+    std::vector<Resource*> resources_;
+    std::unordered_map<uint64_t, ResourceHandle> handles_;
+
+public:
+    ResourceHandle add(const char* name, Resource* resource) {
+        auto hash = intern_hash(name);
+        if (handles_.count(hash) > 0) {
+            fprintf(stderr, "Resource name %s collides with another name\n", name);
+            return INVALID_RESOURCE_HANDLE;
+        }
+        auto handle = (ResourceHandle) resources_.size();
+        resources_.push_back(resource);
+        handles_[hash] = handle;
+        return handle;
+    }
+
+    // INVALID_RESOURCE_HANDLE if nothing was added with that name
+    ResourceHandle find(ResourceName name) const {
+        auto it = handles_.find(name.hash);
+        return it == handles_.end() ? INVALID_RESOURCE_HANDLE : it->second;
+    }
+
+    Resource& operator[](ResourceHandle handle) {
+        return *resources_[handle];
+    }
+};
+
+#endif //PANDAEXPRESS_RESOURCE_NAME_H
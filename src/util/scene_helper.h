@@ -15,8 +15,8 @@
 
 void create_label_text(Blackboard &blackboard, entt::DefaultRegistry &registry,
                        vec2 pos, const char *text) {
-    auto shader = blackboard.shader_manager.get_shader("text");
-    auto mesh = blackboard.mesh_manager.get_mesh("sprite");
+    auto shader = blackboard.shader_manager.get_shader(blackboard.shader_manager.handle(TEXT_SHADER));
+    auto mesh = blackboard.mesh_manager.get_mesh(blackboard.mesh_manager.handle(SPRITE_MESH));
     FontType font = blackboard.fontManager.get_font("titillium_72");
     auto label = registry.create();
     auto &textC = registry.assign<Text>(label, shader, mesh, font, text);
@@ -2,17 +2,41 @@
 // Created by Kenneth William on 2019-03-06.
 //
 
+#include <chrono>
+#include <cstdio>
 #include "sound_manager.h"
 
-SoundManager::SoundManager() {}
+static float elapsed_ms(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+static std::string file_name(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+SoundManager::SoundManager() :
+    currentStage(MAIN_MENU_SCENE_ID),
+    m_sfx(std::make_unique<SfxBank>())
+{}
 
 SoundManager::~SoundManager() {
-    for (auto music : m_background_music) {
-        Mix_FreeMusic(music.second);
+    // stop decoding before freeing what was decoded
+    m_sfx_loader.reset();
+
+    for (auto music : m_music) {
+        if (music.second.music != nullptr) {
+            Mix_FreeMusic(music.second.music);
+        }
     }
 
-    for (auto sfx : m_sfx) {
-        Mix_FreeChunk(sfx.second);
+    if (m_sfx) {
+        for (auto sfx : m_sfx->assets) {
+            if (sfx.second.chunk != nullptr) {
+                Mix_FreeChunk(sfx.second.chunk);
+            }
+        }
     }
 
     SDL_QuitSubSystem(SDL_INIT_AUDIO);
@@ -32,47 +56,144 @@ void SoundManager::init() {
 
     }
 
-    m_sfx[SFX_JUMP] = Mix_LoadWAV(audio_path("jump.wav"));
-    m_sfx[SFX_TELEPORT] = Mix_LoadWAV(audio_path("teleport.wav"));
-    m_sfx[SFX_JACKO_LAUGH] = Mix_LoadWAV(audio_path("JackoLaugh.wav"));
-    m_sfx[SFX_PANDA_HURT] = Mix_LoadWAV(audio_path("PandaHurt.wav"));
-    m_sfx[SFX_BAT_SHOT] = Mix_LoadWAV(audio_path("batShot.wav"));
-    m_sfx[SFX_DRACULA_HIT] = Mix_LoadWAV(audio_path("draculahit.wav"));
-    m_sfx[SFX_DRACULA_LAUGH] = Mix_LoadWAV(audio_path("draculalaugh.wav"));
-    m_sfx[SFX_DRACULA_DEATH] = Mix_LoadWAV(audio_path("draculadeath.wav"));
-    m_sfx[SFX_JACKO_COLLIDE] = Mix_LoadWAV(audio_path("pumhit.wav"));
-    m_sfx[SFX_JACKO_DEATH] = Mix_LoadWAV(audio_path("pumdeath.wav"));
-
-
-
-
-    m_background_music[STORY_BEACH_INTRO_SCENE_ID] = Mix_LoadMUS(audio_path("introscene.ogg"));
-    m_background_music[STORY_JUNGLE_INTRO_SCENE_ID] = Mix_LoadMUS(audio_path("drunkscene.ogg"));
-    m_background_music[MAIN_MENU_SCENE_ID] = Mix_LoadMUS(audio_path("PE.ogg"));
-    m_background_music[STORY_EASY_JUNGLE_SCENE_ID] = Mix_LoadMUS(audio_path("PE.ogg"));
-    m_background_music[ENDLESS_JUNGLE_SCENE_ID] = Mix_LoadMUS(audio_path("PE.ogg"));
-    m_background_music[STORY_HARD_JUNGLE_SCENE_ID] = Mix_LoadMUS(audio_path("PE.ogg"));
-    m_background_music[STORY_EASY_SKY_SCENE_ID] = Mix_LoadMUS(audio_path("vertical2.ogg"));
-    m_background_music[ENDLESS_SKY_SCENE_ID] = Mix_LoadMUS(audio_path("vertical2.ogg"));
-    m_background_music[STORY_HARD_SKY_SCENE_ID] = Mix_LoadMUS(audio_path("vertical2.ogg"));
-    m_background_music[BOSS_SCENE_ID] = Mix_LoadMUS(audio_path("graveyard.ogg"));
-    m_background_music[DRACULA_BOSS_SCENE_ID] = Mix_LoadMUS(audio_path("draculascenemusic.ogg"));
-    m_background_music[STORY_END_SCENE_ID] = Mix_LoadMUS(audio_path("pandaoutro.ogg"));
-
-    m_background_music[INVINCIBILITY_MUSIC] = Mix_LoadMUS(audio_path("invincibility.ogg"));
-    m_background_music[VAPE_HORIZONTAL_MUSIC] = Mix_LoadMUS(audio_path("horizontalslow.ogg"));
-    m_background_music[VAPE_VERTICAL_MUSIC] = Mix_LoadMUS(audio_path("verticalslow.ogg"));
-
-    Mix_PlayMusic(m_background_music[MAIN_MENU_SCENE_ID], -1);
+    m_sfx_loader = std::make_unique<WorkerPool>(1);
+
+    addSFX(SFX_JUMP, audio_path("jump.wav"));
+    addSFX(SFX_TELEPORT, audio_path("teleport.wav"));
+    addSFX(SFX_JACKO_LAUGH, audio_path("JackoLaugh.wav"));
+    addSFX(SFX_PANDA_HURT, audio_path("PandaHurt.wav"));
+    addSFX(SFX_BAT_SHOT, audio_path("batShot.wav"));
+    addSFX(SFX_DRACULA_HIT, audio_path("draculahit.wav"));
+    addSFX(SFX_DRACULA_LAUGH, audio_path("draculalaugh.wav"));
+    addSFX(SFX_DRACULA_DEATH, audio_path("draculadeath.wav"));
+    addSFX(SFX_JACKO_COLLIDE, audio_path("pumhit.wav"));
+    addSFX(SFX_JACKO_DEATH, audio_path("pumdeath.wav"));
+
+
+
+
+    addMusic(STORY_BEACH_INTRO_SCENE_ID, audio_path("introscene.ogg"));
+    addMusic(STORY_JUNGLE_INTRO_SCENE_ID, audio_path("drunkscene.ogg"));
+    addMusic(MAIN_MENU_SCENE_ID, audio_path("PE.ogg"));
+    addMusic(STORY_EASY_JUNGLE_SCENE_ID, audio_path("PE.ogg"));
+    addMusic(ENDLESS_JUNGLE_SCENE_ID, audio_path("PE.ogg"));
+    addMusic(STORY_HARD_JUNGLE_SCENE_ID, audio_path("PE.ogg"));
+    addMusic(STORY_EASY_SKY_SCENE_ID, audio_path("vertical2.ogg"));
+    addMusic(ENDLESS_SKY_SCENE_ID, audio_path("vertical2.ogg"));
+    addMusic(STORY_HARD_SKY_SCENE_ID, audio_path("vertical2.ogg"));
+    addMusic(BOSS_SCENE_ID, audio_path("graveyard.ogg"));
+    addMusic(DRACULA_BOSS_SCENE_ID, audio_path("draculascenemusic.ogg"));
+    addMusic(STORY_END_SCENE_ID, audio_path("pandaoutro.ogg"));
+
+    addMusic(INVINCIBILITY_MUSIC, audio_path("invincibility.ogg"));
+    addMusic(VAPE_HORIZONTAL_MUSIC, audio_path("horizontalslow.ogg"));
+    addMusic(VAPE_VERTICAL_MUSIC, audio_path("verticalslow.ogg"));
+
+    prepareMusic(MAIN_MENU_SCENE_ID);
+    Mix_PlayMusic(m_music[m_music_paths[MAIN_MENU_SCENE_ID]].music, -1);
+}
+
+void SoundManager::addMusic(SceneID id, const char* path) {
+    m_music_paths[id] = path;
+}
+
+void SoundManager::addSFX(SFXID id, const char* path) {
+    auto path_str = std::string(path);
+    m_sfx_paths[id] = path_str;
+
+    SfxBank* bank = m_sfx.get();
+    {
+        std::lock_guard<std::mutex> lock(bank->mutex);
+        if (bank->assets.count(path_str) > 0) {
+            return; // already decoded or queued
+        }
+        bank->assets[path_str] = {nullptr, false, 0.f};
+    }
+    m_sfx_loader->submit([bank, path_str]() {
+        auto start = std::chrono::steady_clock::now();
+        Mix_Chunk* chunk = Mix_LoadWAV(path_str.c_str());
+        float load_ms = elapsed_ms(start);
+        {
+            std::lock_guard<std::mutex> lock(bank->mutex);
+            bank->assets[path_str] = {chunk, true, load_ms};
+        }
+        bank->decoded.notify_all();
+    });
+}
+
+void SoundManager::prepareMusic(SceneID id) {
+    if (m_music_paths.count(id) == 0) {
+        return;
+    }
+    auto& path = m_music_paths[id];
+    if (m_music.count(path) > 0) {
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    MusicAsset asset = {Mix_LoadMUS(path.c_str()), 0, 0.f};
+    asset.load_ms = elapsed_ms(start);
+    if (asset.music == nullptr) {
+        fprintf(stderr, "Failed to load music %s: %s\n", path.c_str(), Mix_GetError());
+    }
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file != nullptr) {
+        fseek(file, 0, SEEK_END);
+        asset.bytes = (size_t) ftell(file);
+        fclose(file);
+    }
+    m_music[path] = asset;
 }
 
 void SoundManager::changeBackgroundMusic(SceneID id) {
-    Mix_PlayMusic(m_background_music[id], -1);
+    prepareMusic(id);
+    if (id != MAIN_MENU_SCENE_ID && id < 14) {
+        // powerups can switch to these at any point during a stage
+        prepareMusic(INVINCIBILITY_MUSIC);
+        prepareMusic(VAPE_HORIZONTAL_MUSIC);
+        prepareMusic(VAPE_VERTICAL_MUSIC);
+    }
+    Mix_Music* music = nullptr;
+    if (m_music_paths.count(id) > 0) {
+        music = m_music[m_music_paths[id]].music;
+    }
+    Mix_PlayMusic(music, -1);
     if(id<14){
         currentStage=id;
     }
 }
 
 void SoundManager::playSFX(SFXID id) {
-    Mix_PlayChannel(id, m_sfx[id], 0);
-}
\ No newline at end of file
+    if (m_sfx_paths.count(id) == 0) {
+        return;
+    }
+    auto& path = m_sfx_paths[id];
+
+    // only blocks if the effect is played before the loader got to it
+    std::unique_lock<std::mutex> lock(m_sfx->mutex);
+    m_sfx->decoded.wait(lock, [this, &path] { return m_sfx->assets[path].done; });
+    Mix_Chunk* chunk = m_sfx->assets[path].chunk;
+    lock.unlock();
+
+    Mix_PlayChannel(id, chunk, 0);
+}
+
+void SoundManager::printReport() {
+    size_t music_bytes = 0;
+    for (auto& music : m_music) {
+        printf("  music %s: %zuKB on disk, opened in %.1fms\n",
+               file_name(music.first).c_str(), music.second.bytes / 1024, music.second.load_ms);
+        music_bytes += music.second.bytes;
+    }
+
+    size_t sfx_bytes = 0;
+    std::lock_guard<std::mutex> lock(m_sfx->mutex);
+    for (auto& sfx : m_sfx->assets) {
+        size_t bytes = sfx.second.chunk != nullptr ? sfx.second.chunk->alen : 0;
+        printf("  sfx %s: %zuKB decoded, %s in %.1fms\n", file_name(sfx.first).c_str(), bytes / 1024,
+               sfx.second.done ? "loaded" : "pending", sfx.second.load_ms);
+        sfx_bytes += bytes;
+    }
+    printf("audio: %zu music tracks (%zuKB), %zu effects (%zuKB)\n",
+           m_music.size(), music_bytes / 1024, m_sfx->assets.size(), sfx_bytes / 1024);
+}
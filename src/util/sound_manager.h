@@ -9,21 +9,59 @@
 
 #include <SDL.h>
 #include <SDL_mixer.h>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <string>
 #include "util/constants.h"
+#include "util/worker_pool.h"
 #include <unordered_map>
 
+// Audio assets are kept in a bank keyed by file path, so a track shared by several
+// scenes is only opened once. Sound effects are decoded on a background thread at
+// init, music is only opened when its scene is about to play it.
 class SoundManager {
 public:
     SoundManager();
+    SoundManager(SoundManager&& other) = default;
     ~SoundManager();
     void init();
+    // opens the scene's music if it isn't already, without playing it
+    void prepareMusic(SceneID id);
     void changeBackgroundMusic(SceneID id);
     void playSFX(SFXID id);
+    // prints memory and load time of every asset loaded so far
+    void printReport();
     SceneID currentStage;
 private:
-    std::unordered_map<SceneID, Mix_Music*> m_background_music;
-    std::unordered_map<SFXID, Mix_Chunk*> m_sfx;
+    struct MusicAsset {
+        Mix_Music* music;
+        size_t bytes; // size of the file, music is streamed from it
+        float load_ms;
+    };
+
+    struct SfxAsset {
+        Mix_Chunk* chunk;
+        bool done; // decoding finished, chunk is null if it failed
+        float load_ms;
+    };
+
+    // SFX state shared with the decoding thread
+    struct SfxBank {
+        std::mutex mutex;
+        std::condition_variable decoded;
+        std::unordered_map<std::string, SfxAsset> assets;
+    };
+
+    void addMusic(SceneID id, const char* path);
+    void addSFX(SFXID id, const char* path);
+
+    std::unordered_map<SceneID, std::string> m_music_paths;
+    std::unordered_map<std::string, MusicAsset> m_music;
+    std::unordered_map<SFXID, std::string> m_sfx_paths;
+    std::unique_ptr<SfxBank> m_sfx;
+    std::unique_ptr<WorkerPool> m_sfx_loader;
 };
 
 
@@ -0,0 +1,98 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#include <cmath>
+#include "timer_wheel.h"
+
+constexpr float TimerWheel::TICK;
+
+TimerWheel::TimerWheel() :
+        now_(0),
+        remainder_(0.f),
+        size_(0),
+        next_handle_(1)
+{}
+
+TimerWheel::Handle TimerWheel::schedule(uint32_t entity, TimerLabel label, float delay) {
+    // the clock is remainder_ past the current tick, the earliest deadline is the next one
+    float ticks = std::ceil((delay + remainder_) / TICK);
+    uint64_t delta = ticks > 1.f ? (uint64_t) ticks : 1;
+    Handle handle = next_handle_++;
+    if (next_handle_ == 0) {
+        next_handle_ = 1;
+    }
+    insert({now_ + delta, {entity, label, handle}});
+    size_++;
+    return handle;
+}
+
+void TimerWheel::insert(const Entry& entry) {
+    uint64_t delta = entry.due - now_;
+    for (int level = 0; level < LEVELS; level++) {
+        uint64_t span = (uint64_t) 1 << (SLOT_BITS * (level + 1));
+        if (delta < span) {
+            slots_[level][(entry.due >> (SLOT_BITS * level)) & (SLOTS - 1)].push_back(entry);
+            return;
+        }
+    }
+    // past the wheel's range, parked in the top level slot cascaded last and placed again from there
+    int top = LEVELS - 1;
+    uint64_t slot = ((now_ >> (SLOT_BITS * top)) + SLOTS - 1) & (SLOTS - 1);
+    slots_[top][slot].push_back(entry);
+}
+
+void TimerWheel::cascade(int level, uint64_t slot) {
+    std::vector<Entry> entries;
+    entries.swap(slots_[level][slot]);
+    for (auto& entry : entries) {
+        insert(entry);
+    }
+}
+
+void TimerWheel::advance(float delta_time, std::vector<Expiry>& expired) {
+    remainder_ += delta_time;
+    if (remainder_ < TICK) {
+        return;
+    }
+    auto ticks = (uint64_t) (remainder_ / TICK);
+    remainder_ -= ticks * TICK;
+    if (size_ == 0) {
+        now_ += ticks; // nothing to cascade or expire on the way
+        return;
+    }
+
+    uint64_t i = 0;
+    for (; i < ticks && size_ > 0; i++) {
+        now_++;
+        // a level's slot comes up when every level below wraps around, higher levels first so
+        // their entries end up in the slots about to be visited
+        int level = 1;
+        while (level < LEVELS && (now_ & (((uint64_t) 1 << (SLOT_BITS * level)) - 1)) == 0) {
+            level++;
+        }
+        for (int l = level - 1; l > 0; l--) {
+            cascade(l, (now_ >> (SLOT_BITS * l)) & (SLOTS - 1));
+        }
+        auto& slot = slots_[0][now_ & (SLOTS - 1)];
+        for (auto& entry : slot) {
+            expired.push_back(entry.expiry);
+        }
+        size_ -= slot.size();
+        slot.clear();
+    }
+    now_ += ticks - i; // the wheel emptied out early
+}
+
+void TimerWheel::clear() {
+    for (auto& level : slots_) {
+        for (auto& slot : level) {
+            slot.clear();
+        }
+    }
+    size_ = 0;
+}
+
+size_t TimerWheel::size() const {
+    return size_;
+}
@@ -0,0 +1,66 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#ifndef PANDAEXPRESS_TIMER_WHEEL_H
+#define PANDAEXPRESS_TIMER_WHEEL_H
+
+#include <cstdint>
+#include <vector>
+#include <components/timer.h>
+
+// Hierarchical timer wheel: LEVELS rings of SLOTS slots, each slot of a level spanning a whole
+// ring of the level below. Scheduling and expiring are constant time per entry, an entry is
+// moved down a level at most LEVELS - 1 times, and advancing only visits the slots the clock
+// passes instead of every pending watch. Entries aren't cancelled, the owner checks the handle
+// of an expiry against the watch it still has and drops the stale ones.
+class TimerWheel {
+public:
+    // 0 never names an entry
+    typedef uint32_t Handle;
+
+    struct Expiry {
+        uint32_t entity;
+        TimerLabel label;
+        Handle handle;
+    };
+
+    // resolution of the wheel, delays are rounded up to whole ticks
+    static constexpr float TICK = 1.f / 120.f;
+
+    TimerWheel();
+
+    // the entry expires once delay seconds of advance() have passed, at least one tick from now
+    Handle schedule(uint32_t entity, TimerLabel label, float delay);
+
+    // appends the entries that expired while advancing, oldest deadline first
+    void advance(float delta_time, std::vector<Expiry>& expired);
+
+    void clear();
+
+    // entries scheduled and not expired yet, stale ones included
+    size_t size() const;
+
+private:
+    static const int SLOT_BITS = 6;
+    static const uint64_t SLOTS = 1 << SLOT_BITS;
+    static const int LEVELS = 4; // 2^24 ticks, about 38 hours, further deadlines wait on the top level
+
+    struct Entry {
+        uint64_t due; // in ticks
+        Expiry expiry;
+    };
+
+    void insert(const Entry& entry);
+
+    // moves the entries of a slot that's coming up to the levels below
+    void cascade(int level, uint64_t slot);
+
+    std::vector<Entry> slots_[LEVELS][SLOTS];
+    uint64_t now_; // ticks advanced so far
+    float remainder_; // time advanced that doesn't make a whole tick yet
+    size_t size_;
+    Handle next_handle_;
+};
+
+#endif //PANDAEXPRESS_TIMER_WHEEL_H
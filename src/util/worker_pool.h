@@ -0,0 +1,43 @@
+//
+// Created by agent on 19/10/26.
+//
+
+#ifndef PANDAEXPRESS_WORKER_POOL_H
+#define PANDAEXPRESS_WORKER_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of background threads running jobs in submission order
+// Jobs must not touch OpenGL, the GL context only lives on the main thread
+class WorkerPool {
+public:
+    // 0 threads picks one less than the hardware concurrency, at least 1
+    explicit WorkerPool(size_t threads = 0);
+
+    // drops jobs that haven't started and joins the threads
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    void submit(std::function<void()> job);
+
+    size_t size() const;
+
+private:
+    std::vector<std::thread> threads_;
+    std::deque<std::function<void()>> jobs_;
+    std::mutex mutex_;
+    std::condition_variable job_ready_;
+    bool stopping_;
+
+    void run();
+};
+
+
+#endif //PANDAEXPRESS_WORKER_POOL_H